@@ -0,0 +1,353 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <sys/stat.h>
+
+#include "wing.h"
+#include "utils.h"
+#include "types.h"
+#include "fileio.h"
+#include "engine.h"
+#include "parsing.h"
+#include "constants.h"
+#include "validation.h"
+
+typedef struct BenchCase {
+    const char *name;
+    const char *airfoil;
+    int num_surface_pts;
+    bool is_lednicer;
+} BenchCase;
+
+typedef struct BenchResult {
+    const char *stage;
+    const char *airfoil;
+    const char *format;
+    int num_pts_chord;
+    int num_slices;
+    long iterations;
+    double seconds;
+    double vertices;
+    double triangles;
+    double bytes;
+} BenchResult;
+
+double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double) ts.tv_sec + 1e-9 * (double) ts.tv_nsec;
+}
+
+double get_file_size(const char *fname) {
+    struct stat st;
+    return (stat(fname, &st) == 0) ? (double) st.st_size : 0.0;
+}
+
+int write_synthetic_dat(const char *fname, int num_surface_pts, bool is_lednicer) {
+    FILE *f = fopen(fname, "w");
+
+    if (f == NULL) {
+        fprintf(stderr, "bench: error: unable to write %s\n", fname);
+        return 1;
+    }
+
+    int n = num_surface_pts - 1;
+    float x, t;
+
+    fprintf(f, "SYNTHETIC %s %d\n", is_lednicer ? "LEDNICER" : "SELIG", num_surface_pts);
+
+    if (is_lednicer) {
+        fprintf(f, "%d. %d.\n\n", num_surface_pts, num_surface_pts);
+    }
+
+    for (int side = 0; side < 2; side++) {
+        for (int k = 0; k <= n; k++) {
+            int i = (is_lednicer || side == 1) ? k : n - k;
+
+            if (!is_lednicer && side == 1 && i == 0) {
+                continue;
+            }
+
+            x = 0.5f * (1.0f - cosf(PI * (float) i / (float) n));
+            t = 0.6f * (0.2969f * sqrtf(x) - 0.126f * x - 0.3516f * x * x + 0.2843f * x * x * x - 0.1036f * x * x * x * x);
+            fprintf(f, "%.9f %.9f\n", x, (side == 0) ? t : -t);
+        }
+
+        if (is_lednicer && side == 0) {
+            fprintf(f, "\n");
+        }
+    }
+
+    return fclose(f) != 0;
+}
+
+void print_result(const BenchResult *r) {
+    double ns_per_iter = 1e9 * r->seconds / (double) r->iterations;
+
+    printf("{\"stage\": \"%s\", \"airfoil\": \"%s\", \"format\": \"%s\", \"p\": %d, \"n\": %d, "
+           "\"iterations\": %ld, \"ns_per_iter\": %.1f",
+           r->stage, r->airfoil, r->format, r->num_pts_chord, r->num_slices, r->iterations, ns_per_iter);
+
+    if (r->vertices > 0.0) {
+        printf(", \"ns_per_vertex\": %.3f", ns_per_iter / r->vertices);
+    }
+
+    if (r->triangles > 0.0) {
+        printf(", \"triangles_per_s\": %.0f", r->triangles * 1e9 / ns_per_iter);
+    }
+
+    if (r->bytes > 0.0) {
+        printf(", \"mb_per_s\": %.2f", r->bytes * 1e3 / ns_per_iter);
+    }
+
+    printf("}\n");
+    fflush(stdout);
+}
+
+int bench_parse(const BenchCase *bench, double min_seconds) {
+    BenchResult result = {.stage = "read_dat", .airfoil = bench->name, .format = "dat"};
+    Airfoil airfoil = (Airfoil) {.num_pts = DEFAULT_AIRFOIL};
+
+    double start = now_seconds();
+
+    do {
+        if (read_dat(bench->airfoil, &airfoil, false)) {
+            return 1;
+        }
+
+        result.vertices = airfoil.num_pts;
+        free_airfoil(&airfoil);
+        result.iterations++;
+        result.seconds = now_seconds() - start;
+    } while (result.seconds < min_seconds);
+
+    result.bytes = get_file_size(bench->airfoil);
+    print_result(&result);
+
+    return 0;
+}
+
+int bench_mesh(Settings *settings, const char *airfoil, const char *scratch, double min_seconds) {
+    if (validate_settings(settings)) {
+        return 1;
+    }
+
+    size_t num_pts = get_num_pts(settings);
+    size_t num_tris = get_num_tris(settings);
+    int n = settings->num_slices;
+
+    BenchResult result = {
+        .airfoil = airfoil, .num_pts_chord = settings->num_pts_chord, .num_slices = n
+    };
+
+    Vec3D *pts = NULL;
+    double start = now_seconds();
+
+    result.stage = "make_pts";
+    result.format = "none";
+    result.vertices = (double) num_pts;
+
+    do {
+        free(pts);
+        pts = make_pts(settings);
+
+        if (pts == NULL) {
+            return 1;
+        }
+
+        result.iterations++;
+        result.seconds = now_seconds() - start;
+    } while (result.seconds < min_seconds);
+
+    print_result(&result);
+
+    Index *indices = (Index *) malloc(3 * num_tris * sizeof(Index));
+
+    if (indices == NULL) {
+        free(pts);
+        return 1;
+    }
+
+    result.stage = "assign_indices";
+    result.iterations = 0;
+    result.vertices = 0.0;
+    result.triangles = (double) num_tris * n;
+    start = now_seconds();
+
+    do {
+        for (int islice = 0; islice < n; islice++) {
+            assign_indices(settings, num_tris, islice, indices);
+        }
+
+        result.iterations++;
+        result.seconds = now_seconds() - start;
+    } while (result.seconds < min_seconds);
+
+    print_result(&result);
+
+    free(indices);
+    free(pts);
+
+    const char *formats[] = {"ascii", "binary", "ply", "obj", "3mf"};
+    Writer writer = {.data = NULL, .size = 0, .capacity = 0, .stats = NULL};
+    int status = 0;
+
+    settings->output = (char *) malloc((strlen(scratch) + 1) * sizeof(char));
+
+    if (settings->output == NULL) {
+        return 1;
+    }
+
+    strcpy(settings->output, scratch);
+    char *name = (char *) malloc(get_name_length(settings) * sizeof(char));
+
+    if (name == NULL) {
+        return 1;
+    }
+
+    for (int iformat = 0; iformat < 5 && !status; iformat++) {
+        settings->format = to_format(formats[iformat]);
+        handle_output_ext(settings);
+
+        result.stage = "generate_wing";
+        result.format = formats[iformat];
+        result.iterations = 0;
+        start = now_seconds();
+
+        do {
+            status = generate_wing(settings, 1, &writer, NULL);
+
+            result.iterations++;
+            result.seconds = now_seconds() - start;
+        } while (result.seconds < min_seconds && !status);
+
+        result.bytes = 0.0;
+
+        for (int islice = 0; islice < n; islice++) {
+            if (settings->format == THREE_MF) {
+                strcpy(name, settings->output);
+            } else {
+                make_slice_name(settings, islice, name);
+            }
+
+            result.bytes += get_file_size(name);
+            remove(name);
+        }
+
+        if (!status) {
+            print_result(&result);
+        }
+    }
+
+    free_writer(&writer);
+    free(name);
+
+    return status;
+}
+
+int main(int argc, char **argv) {
+    bool is_quick = false;
+    const char *dir = ".";
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-q") == 0) {
+            is_quick = true;
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            dir = argv[++i];
+        } else {
+            fprintf(stderr, "usage: bench [-q] [-o SCRATCH_DIR]\n");
+            return 1;
+        }
+    }
+
+    char selig[MAX_LINE], lednicer[MAX_LINE], large[MAX_LINE], scratch[MAX_LINE];
+
+    snprintf(selig, MAX_LINE, "%s/bench_selig.dat", dir);
+    snprintf(lednicer, MAX_LINE, "%s/bench_lednicer.dat", dir);
+    snprintf(large, MAX_LINE, "%s/bench_large.dat", dir);
+    snprintf(scratch, MAX_LINE, "%s/bench_out.stl", dir);
+
+    if (write_synthetic_dat(selig, 81, false) || write_synthetic_dat(lednicer, 81, true) ||
+        write_synthetic_dat(large, is_quick ? 2000 : 20000, false)) {
+        return 1;
+    }
+
+    BenchCase cases[] = {
+        {"naca2412", "2412", 0, false},
+        {"naca0012", "0012", 0, false},
+        {"selig", selig, 81, false},
+        {"lednicer", lednicer, 81, true},
+        {"large", large, is_quick ? 2000 : 20000, false}
+    };
+
+    int chord_pts[] = {50, 200, 1000};
+    int slices[] = {1, 8, 32};
+
+    double min_seconds = is_quick ? 0.02 : 0.2;
+    int num_chord = is_quick ? 2 : 3;
+    int num_slices = is_quick ? 2 : 3;
+    int status = 0;
+
+    for (int icase = 0; icase < 5 && !status; icase++) {
+        const BenchCase *bench = cases + icase;
+
+        if (bench->num_surface_pts > 0 && bench_parse(bench, min_seconds)) {
+            status = 1;
+            break;
+        }
+
+        for (int ip = 0; ip < num_chord && !status; ip++) {
+            for (int in = 0; in < num_slices && !status; in++) {
+                Settings settings;
+                init_settings(&settings);
+
+                char *args[] = {"bench", FLAG_AIRFOIL, (char *) bench->airfoil};
+                handle_airfoil(1, 3, args, &settings.airfoil, &settings);
+
+                settings.semi_span = 3.0f;
+                settings.root_chord = 1.0f;
+                settings.num_pts_chord = chord_pts[ip];
+                settings.num_slices = slices[in];
+
+                status = settings.airfoil.num_pts < 0 || bench_mesh(&settings, bench->name, scratch, min_seconds);
+                free_settings(&settings);
+            }
+        }
+    }
+
+    remove(selig);
+    remove(lednicer);
+    remove(large);
+
+    return status;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
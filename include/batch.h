@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "types.h"
+
+int split_args(char *line, char **args, int max_args);
+void free_job(Job *job);
+int add_job(BatchContext *batch, const Job *job);
+int parse_job(BatchContext *batch, int num_args, char **args, char *line, int line_no);
+int read_manifest(const char *fname, int num_args, char **args, BatchContext *batch);
+int run_job(void *context, int ijob, int iworker);
+int run_batch(const Settings *settings, int num_args, char **args, Stats *stats);
+
+void report_job(void *context, int ijob);
+void free_batch(BatchContext *batch, int num_workers);
+void free_airfoil_cache(AirfoilCache *cache);
+
+Airfoil *find_airfoil(AirfoilCache *cache, const char *key);
+Airfoil *load_airfoil(AirfoilCache *cache, const char *key, const Settings *settings);
+
+#endif
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stdbool.h>
+
+#include "types.h"
+
+char *make_cache_path(const char *cache_dir, const char *key);
+
+int stamp_source(const char *fname, const char *key, CacheHeader *stamp);
+int read_cache_entry(const char *path, const char *key, const CacheHeader *stamp, Airfoil *airfoil);
+int write_cache_entry(const char *path, const char *key, const CacheHeader *stamp, const Airfoil *airfoil);
+int load_dat(const char *fname, Airfoil *airfoil, const char *cache_dir, bool quiet);
+
+size_t get_entry_size(const CacheHeader *header);
+void *copy_entry_array(const char **src, size_t num_bytes);
+bool is_entry_valid(const CacheHeader *header, const CacheHeader *stamp, size_t size);
+
+#endif
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
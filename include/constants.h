@@ -6,6 +6,8 @@
 #ifndef CONSTANTS_H
 #define CONSTANTS_H
 
+#include <limits.h>
+
 #define A0 0.2969f
 #define A1 -0.126f
 #define A2 -0.3516f
@@ -20,16 +22,87 @@
 #define MIN_SWEEP 1
 #define MAX_SWEEP 179
 #define MIN_CHORD_PTS 20
-#define MAX_CHORD_PTS 200
+#define MAX_CHORD_PTS (INT_MAX / 4)
 #define MIN_NUM_SLICES 1
-#define MAX_NUM_SLICES 50
+#define MAX_NUM_SLICES (INT_MAX / 2)
 #define MIN_AIRFOIL_PTS 3
-#define MAX_AIRFOIL_PTS 1000
+#define INITIAL_AIRFOIL_PTS 256
 #define MIN_ASPECT_RATIO 1.0f
 #define MAX_ASPECT_RATIO 100.0f
 
+#ifndef INDEX_BITS
+#define INDEX_BITS 32
+#endif
+
+#define STL_HEADER_SIZE 80
+#define STL_FACET_SIZE 50
+#define PLY_VERTEX_SIZE 12
+#define PLY_FACE_SIZE 13
+#define ZIP_MAX_ENTRIES 3
+#define ZIP_LOCAL_SIZE 30
+#define ZIP_DESCRIPTOR_SIZE 16
+#define ZIP_CENTRAL_SIZE 46
+#define ZIP_END_SIZE 22
+#define ZIP_VERSION 20
+#define ZIP_FLAG_DESCRIPTOR 0x0008
+#define ZIP_DOS_DATE 0x0021
+#define ZIP_LOCAL_SIG 0x04034b50
+#define ZIP_DESCRIPTOR_SIG 0x08074b50
+#define ZIP_CENTRAL_SIG 0x02014b50
+#define ZIP_END_SIG 0x06054b50
+#define THREE_MF_UNIT "meter"
+#define CRC32_POLY 0xEDB88320u
+#define MAX_HEADER_CHARS 512
+#define MAX_JOB_ARGS 256
+#define MAX_MANIFEST_LINE 4096
+#define MAX_DECIMAL_DIGITS 19
+#define MAX_DECIMAL_EXP 9999
+#define TAR_BLOCK_SIZE 512
+#define CACHE_MAGIC "WSAF"
+#define CACHE_VERSION 1
+#define CACHE_BYTE_ORDER 0x01020304
+#define CACHE_EXT ".wsaf"
+#define STORE_MAGIC "WSOC"
+#define STORE_VERSION 2
+#define STORE_RECORD "record"
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+#define WRITE_BUFFER_SIZE 1048576
+#define WRITE_BUFFER_ALIGN 4096
+#define MAX_FLOAT_CHARS 64
+#define MAX_FACET_CHARS 1024
+#define MAX_SPLINE_ITERS 40
+#define SPACING_SAMPLES 1024
+#define SPACING_COSINE_SHARE 0.25
+#define DEVIATION_SAMPLES 8
+#define MAX_TOLERANCE_PTS 65536
+#define MIN_THREADS 1
+#define MAX_THREADS 256
+#define MIN_MEMORY_BUDGET 1
+#define MAX_MEMORY_BUDGET 1073741824
+#define BYTES_PER_MIB 1048576.0
+#define MIN_DECIMALS 0
+#define MAX_DECIMALS 9
+#define MAX_FLOAT_DIGITS 9
+#define FORMAT_FLOAT_LIMIT 4294967296.0f
+
 #define FLAG_HELP "-h"
+#define FLAG_FORMAT "-f"
+#define FLAG_SPACING "-i"
+#define FLAG_TOLERANCE "-q"
+#define FLAG_DECIMALS "-d"
+#define FLAG_NUM_THREADS "-j"
 #define FLAG_UNITS "-u"
+#define FLAG_SPLINE "-s"
+#define FLAG_STREAM "-m"
+#define FLAG_MANIFEST "-x"
+#define FLAG_CACHE "-k"
+#define FLAG_STORE "-w"
+#define FLAG_LIBRARY "-L"
+#define FLAG_REPORT "-r"
+#define FLAG_ESTIMATE "-e"
+#define FLAG_MEMORY_BUDGET "-z"
+#define FLAG_DISK_CHECK "-g"
 #define FLAG_OUTPUT "-o"
 #define FLAG_AIRFOIL "-a"
 #define FLAG_VERBOSE "-v"
@@ -42,6 +115,13 @@
 
 #define DEFAULT_UNITS "m"
 #define DEFAULT_OUTPUT "wing.stl"
+#define REPORT_STDOUT "-"
+#define OUTPUT_STDOUT "-"
+#define OUTPUT_FD_PREFIX "fd:"
+#define DEFAULT_FORMAT "ascii"
+#define DEFAULT_SPACING "cosine"
+#define DEFAULT_DECIMALS 6
+#define DEFAULT_NUM_THREADS 1
 #define DEFAULT_AIRFOIL -1
 #define DEFAULT_SWEEP_LE 90.0f
 #define DEFAULT_SWEEP_TE 90.0f
@@ -49,6 +129,7 @@
 #define DEFAULT_ROOT_CHORD -1.0f
 #define DEFAULT_NUM_SLICES 1
 #define DEFAULT_NUM_CHORD_PTS 100
+#define DEFAULT_TOLERANCE 0.0f
 #define DEFAULT_HAS_CLOSED_TE 1
 
 #define FEET_PER_METER 3.28084f
@@ -13,35 +13,57 @@
 
 float get_surface_area(const Settings *settings);
 float get_aspect_ratio(const Settings *settings);
+float get_max_chord(const Settings *settings);
 float get_naca4_camber(float x, float m, float p);
 float get_naca4_gradient(float x, float m, float p);
 float get_naca4_thickness(float x, float t, bool is_closed);
 float get_naca4_surface_x(float xc, float thickness, float theta, bool is_upper);
 float get_naca4_surface_z(float zc, float thickness, float theta, bool is_upper);
-float get_selig_upper_z(float xc, Airfoil *airfoil);
-float get_selig_lower_z(float xc, Airfoil *airfoil);
-float get_lednicer_upper_z(float xc, Airfoil *airfoil);
-float get_lednicer_lower_z(float xc, Airfoil *airfoil);
-float get_lednicer_z(float xc, Airfoil *airfoil, bool is_upper);
-float get_selig_z(float xc, Airfoil *airfoil, bool is_upper);
-float get_surface_z(float xn_camber, Airfoil *airfoil, bool is_upper);
-float get_surface_x(float xn_camber, Airfoil *airfoil, bool is_upper);
+float get_dat_z(float xc, const Airfoil *airfoil, bool is_upper);
+float get_spline_z(float xc, const Airfoil *airfoil, bool is_upper);
+float get_surface_z(float xn_camber, const Airfoil *airfoil, bool is_upper);
+float get_surface_x(float xn_camber, const Airfoil *airfoil, bool is_upper);
 
+SimdLevel get_simd_level(void);
+
+size_t get_num_col_pts(const Settings *settings);
 size_t get_num_pts(const Settings *settings);
 size_t get_num_tris(const Settings *settings);
 size_t get_upper_index(const Settings *settings, int i, int j);
 size_t get_lower_index(const Settings *settings, int i, int j);
 
-size_t fill_upper_lower_indices(const Settings *settings, size_t k, size_t *inds, int islice);
-size_t fill_port_star_indices(const Settings *settings, size_t k, size_t *inds, int islice);
-size_t fill_aft_indices(const Settings *settings, size_t k, size_t *inds, int islice);
+size_t fill_upper_lower_indices(const Settings *settings, size_t k, Index *inds, int islice);
+size_t fill_port_star_indices(const Settings *settings, size_t k, Index *inds, int islice);
+size_t fill_aft_indices(const Settings *settings, size_t k, Index *inds, int islice);
+
+int find_segment(const Surface *surf, float xc);
+int make_surfaces(Airfoil *airfoil);
+int make_spline(Airfoil *airfoil);
+int fill_row(void *context, int i, int iworker);
+int make_profile(const Settings *settings, Profile *profile);
+int fill_pts(const Settings *settings, Vec3D *pts);
+
+Vec3D *make_pts(const Settings *settings);
 
-Vec3D *make_pts(Settings *settings);
+void init_grid(const Settings *settings, const Profile *profile, Vec3D *pts, int first_col, int num_cols, PointContext *grid);
+void make_slice_pts(const Settings *settings, const Profile *profile, int islice, Vec3D *pts);
+void make_slice_settings(const Settings *settings, Settings *slice_settings);
 
 bool tip_overlap(const Settings *settings);
 
+void get_naca4_params(const Airfoil *airfoil, float *m, float *p, float *t);
+void naca4_section_scalar(const float *x, int istart, int n, const Naca4 *naca,
+                          float *thickness, float *zn_camber, float *theta);
+void naca4_surface_scalar(const float *x, int istart, int n, float *xu, float *zu, float *xl, float *zl);
+void get_naca4_batch(const float *x, int n, const Airfoil *airfoil, SimdLevel level,
+                     float *xu, float *zu, float *xl, float *zl);
+void fill_dat_profile(const Airfoil *airfoil, Profile *profile, bool use_spline);
+void free_profile(Profile *profile);
 void adjust_and_scale(Airfoil *airfoil, float xmin, float xmax);
-void assign_indices(const Settings *settings, size_t num_tris, int islice, size_t *indices);
+int copy_airfoil(Airfoil *dst, const Airfoil *src);
+void free_airfoil(Airfoil *airfoil);
+void eval_spline(const Spline *spline, int k, float t, Vec2D *p);
+void assign_indices(const Settings *settings, size_t num_tris, int islice, Index *indices);
 
 #endif
 
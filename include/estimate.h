@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#ifndef ESTIMATE_H
+#define ESTIMATE_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "types.h"
+
+size_t get_fixed_bytes(Format format, size_t num_pts, size_t num_tris);
+size_t get_memory_estimate(const Settings *settings, int num_workers);
+size_t get_free_disk(const char *output);
+size_t get_physical_memory(void);
+
+int alloc_estimate(Estimate *estimate, const Settings *settings);
+void free_estimate(Estimate *estimate);
+int count_slice_bytes(const Settings *settings, Estimate *estimate, int islice, Format format, size_t *num_bytes);
+int show_estimate(const Settings *settings, int num_workers);
+int check_budget(const Settings *settings, int num_workers);
+
+#endif
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
@@ -8,12 +8,41 @@
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <sys/uio.h>
 
 #include "types.h"
 
-int read_dat(const char *fname, Airfoil *data);
-int write_stl(Vec3D *pts, const size_t *indices, size_t num_tris, const char *fname);
+const char *skip_space(const char *ptr, const char *end);
+const char *parse_decimal(const char *ptr, const char *end, float *value);
+int map_file(const char *fname, const char **data, size_t *size);
+void unmap_file(const char *data, size_t size);
+int grow_airfoil(Airfoil *airfoil);
+int parse_dat(const char *data, size_t size, Airfoil *airfoil, bool quiet);
+int read_dat(const char *fname, Airfoil *airfoil, bool quiet);
+int open_writer(Writer *writer, const char *fname);
+int send_writer(Writer *writer, struct iovec *iov, int iovcnt);
+int flush_writer(Writer *writer);
+int write_direct(Writer *writer, const void *data, size_t num_bytes);
+int close_writer(Writer *writer);
+void free_writer(Writer *writer);
+int write_text(Writer *writer, const char *text);
+int write_ascii_stl(Writer *writer, Vec3D *pts, const Index *indices, size_t num_tris, const char *fname, int decimals);
+int write_binary_stl(Writer *writer, Vec3D *pts, const Index *indices, size_t num_tris, const char *fname);
+int format_ply_header(char *header, size_t num_pts, size_t num_tris);
+int write_binary_ply(Writer *writer, const Vec3D *pts, size_t num_pts, const Index *indices, size_t num_tris, const char *fname);
+int write_ascii_obj(Writer *writer, const Vec3D *pts, size_t num_pts, const Index *indices, size_t num_tris, const char *fname, int decimals);
+int write_mesh(const Settings *settings, Writer *writer, Vec3D *pts, size_t num_pts, const Index *indices, size_t num_tris, const char *fname);
+
+size_t get_name_length(const Settings *settings);
+
+char *reserve_bytes(Writer *writer, size_t num_bytes);
+char *append_text(char *dst, const char *text);
+char *append_vec(char *dst, const Vec3D *v, int decimals);
+
+void commit_bytes(Writer *writer, size_t num_bytes);
+void make_slice_name(const Settings *settings, int islice, char *name);
 LineResult parse_line(const char *line, bool first_line, float *x, float *y);
+LineResult scan_line(const char *start, const char *end, bool first_line, float *x, float *y);
 
 #endif
 
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#ifndef LIBRARY_H
+#define LIBRARY_H
+
+#include <stdbool.h>
+
+#include "types.h"
+
+char *make_entry_name(const char *path, size_t length);
+
+int add_entry(Library *library, const char *member, size_t length, char *path, const char *data, size_t size);
+int scan_directory(const char *dir_name, Library *library);
+int scan_archive(const char *fname, Library *library);
+int compare_entries(const void *a, const void *b);
+int load_entry(void *context, int ientry, int iworker);
+int load_library(const char *path, Library *library, const char *cache_dir, int num_threads);
+int select_entry(const Library *library, const LibraryEntry *entry, Airfoil *airfoil, const char *cache_dir);
+
+bool is_tar_header_valid(const unsigned char *block);
+
+const LibraryEntry *find_entry(const Library *library, const char *name);
+
+void free_library(Library *library);
+
+#endif
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#ifndef LIBWINGSTL_H
+#define LIBWINGSTL_H
+
+#include <stdlib.h>
+
+#include "types.h"
+
+/*
+ * Embeddable interface to wing generation. A context holds one wing and
+ * its buffers; separate contexts may be used from separate threads at the
+ * same time. Bulk buffers come from the allocator passed to wingstl_create
+ * (malloc and free when NULL). wingstl_serialize writes one slice in the
+ * configured format to a caller-owned buffer and stores the full size in
+ * *size; it returns 1 without an error message if the buffer is too small.
+ * wingstl_serialize_alloc instead returns a buffer from the context's
+ * allocator that the caller releases with the same allocator.
+ */
+
+WingContext *wingstl_create(const Allocator *allocator);
+int wingstl_setup(WingContext *ctx, int num_args, char **args);
+int wingstl_num_slices(const WingContext *ctx);
+size_t wingstl_num_pts(const WingContext *ctx);
+size_t wingstl_num_tris(const WingContext *ctx);
+int wingstl_make_pts(WingContext *ctx, const Vec3D **pts, size_t *num_pts);
+int wingstl_make_indices(WingContext *ctx, int islice, const Index **indices, size_t *num_tris);
+int wingstl_serialize(WingContext *ctx, int islice, char *buffer, size_t capacity, size_t *size);
+int wingstl_serialize_alloc(WingContext *ctx, int islice, char **data, size_t *size);
+void wingstl_reset(WingContext *ctx);
+void wingstl_destroy(WingContext *ctx);
+
+#endif
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
@@ -14,15 +14,28 @@ void request_n_digits(const char *desc, const char *flag, int n);
 void request_bounded_integer(const char *desc, const char *flag, int val, const char *qualifier);
 
 int handle_chord_pts(int iarg, int num_args, char **args);
+int handle_decimals(int iarg, int num_args, char **args);
+int handle_num_threads(int iarg, int num_args, char **args);
+int handle_memory_budget(int iarg, int num_args, char **args);
+int handle_output_ext(Settings *settings);
 int handle_inputs(int num_args, char **args, Settings *settings);
 
 float handle_sweep(int iarg, int num_args, char **args, const char *arg_flag);
 float handle_nonzero_positive(int iarg, int num_args, char **args, const char *desc, const char *flag);
 
 char *handle_output(int iarg, int num_args, char **args);
+char *handle_manifest(int iarg, int num_args, char **args);
+char *handle_library(int iarg, int num_args, char **args);
+char *handle_cache_dir(int iarg, int num_args, char **args);
+char *handle_store_dir(int iarg, int num_args, char **args);
+char *handle_report(int iarg, int num_args, char **args);
 
 Units handle_units(int iarg, int num_args, char **args);
-void handle_airfoil(int iarg, int num_args, char **args, Airfoil *airfoil);
+Format handle_format(int iarg, int num_args, char **args);
+Spacing handle_spacing(int iarg, int num_args, char **args);
+void handle_airfoil(int iarg, int num_args, char **args, Airfoil *airfoil, const Settings *settings);
+void init_settings(Settings *settings);
+void free_settings(Settings *settings);
 
 #endif
 
@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#ifndef SINK_H
+#define SINK_H
+
+#include <stdlib.h>
+#include <sys/uio.h>
+
+#include "types.h"
+
+SinkKind to_sink_kind(const char *output);
+int get_sink_fd(const char *output);
+int open_sink(Sink *sink, const char *fname);
+int grow_target(Sink *sink, size_t num_bytes);
+int write_sink(Sink *sink, struct iovec *iov, int iovcnt);
+int close_sink(Sink *sink);
+
+#endif
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
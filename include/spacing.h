@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#ifndef SPACING_H
+#define SPACING_H
+
+#include <stdbool.h>
+
+#include "types.h"
+
+void sample_section(const Settings *settings, const float *xs, int n, Vec2D *upper, Vec2D *lower);
+float get_distance(const Vec2D *a, const Vec2D *b);
+float get_curvature(const Vec2D *a, const Vec2D *b, const Vec2D *c);
+float get_point_curvature(const Vec2D *pts, const Vec2D *other, int k, int n);
+void get_spacing_weights(const Settings *settings, const Vec2D *upper, const Vec2D *lower, int n, float *weights);
+void invert_weights(const float *xs, float *weights, int num_samples, float *stations, int n);
+int fill_stations(const Settings *settings, float *stations, int n);
+float get_segment_distance(const Vec2D *p, const Vec2D *a, const Vec2D *b);
+int get_max_deviation(const Settings *settings, int n, float *deviation);
+int meets_tolerance(const Settings *settings, int n, float tolerance, bool *is_met);
+int select_chord_pts(Settings *settings);
+
+#endif
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
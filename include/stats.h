@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdlib.h>
+
+#include "types.h"
+
+double get_wall_time(void);
+double get_cpu_time(bool is_process);
+size_t get_peak_memory(void);
+const char *get_stage_name(Stage stage);
+
+void start_timer(Timer *timer, bool is_process);
+void stop_timer(const Timer *timer, Stats *stats, Stage stage);
+void exclude_stage(Stats *stats, Stage stage, Stage nested, const StageTime *nested_before);
+void add_stats(Stats *dst, const Stats *src);
+void show_report(const Stats *stats, const StageTime *total);
+
+int write_report(const char *fname, const Stats *stats, const StageTime *total, int status);
+int report_stats(const Settings *settings, const Stats *stats, const Timer *run, int status);
+
+#endif
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#ifndef STORE_H
+#define STORE_H
+
+#include <stdint.h>
+
+#include "types.h"
+
+uint64_t get_store_key(const Settings *settings, StoreKey *key);
+int get_num_entries(const Settings *settings);
+size_t get_entry_length(const SliceContext *slices);
+void make_entry_path(const SliceContext *slices, int ientry, char *path);
+void make_entry_output(const Settings *settings, int ientry, char *name);
+size_t get_record_size(const StoreKey *key, int num_entries);
+void make_record_path(const SliceContext *slices, char *path);
+int read_store_record(SliceContext *slices, const StoreKey *key);
+int write_store_record(const SliceContext *slices, const StoreKey *key);
+int hash_file(const char *fname, StoreEntry *entry);
+int copy_file(const char *src, const char *dst);
+int install_file(const char *src, const char *dst);
+int open_store(SliceContext *slices);
+void store_slices(SliceContext *slices);
+void close_store(SliceContext *slices);
+
+#endif
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
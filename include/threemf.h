@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#ifndef THREEMF_H
+#define THREEMF_H
+
+#include <stdlib.h>
+
+#include "types.h"
+
+int write_zip_header(Writer *writer, uint32_t signature, const ZipEntry *entry);
+int begin_entry(Package *package, const char *name);
+int end_entry(Package *package);
+int write_central_directory(Package *package);
+int open_package(Package *package, Writer *writer, const char *fname);
+int close_package(Package *package, int num_objects);
+int write_3mf_object(Writer *writer, const Vec3D *pts, size_t num_pts, const Index *indices, size_t num_tris, int id, int decimals);
+int write_3mf(const Settings *settings, Writer *writer, const Vec3D *pts, size_t num_pts, const Index *indices, size_t num_tris, const char *fname);
+
+size_t get_package_overhead(const Settings *settings, Writer *counter);
+
+#endif
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
@@ -6,9 +6,22 @@
 #ifndef TYPES_H
 #define TYPES_H
 
+#include <stdio.h>
+#include <stdint.h>
 #include <stdbool.h>
 #include "constants.h"
 
+#if INDEX_BITS == 16
+typedef uint16_t Index;
+#define MAX_INDEX UINT16_MAX
+#elif INDEX_BITS == 64
+typedef uint64_t Index;
+#define MAX_INDEX UINT64_MAX
+#else
+typedef uint32_t Index;
+#define MAX_INDEX UINT32_MAX
+#endif
+
 typedef struct Vec2D {
     float x, y;
 } Vec2D;
@@ -26,6 +39,22 @@ typedef enum Units {
     UNKNOWN_UNITS
 } Units;
 
+typedef enum Format {
+    ASCII_STL,
+    BINARY_STL,
+    BINARY_PLY,
+    ASCII_OBJ,
+    THREE_MF,
+    UNKNOWN_FORMAT
+} Format;
+
+typedef enum Spacing {
+    COSINE_SPACING,
+    ARC_SPACING,
+    CURVATURE_SPACING,
+    UNKNOWN_SPACING
+} Spacing;
+
 typedef enum LineResult {
     VALUE_LINE,
     EMPTY_BODY_LINE,
@@ -35,31 +64,317 @@ typedef enum LineResult {
     INVALID_FORMAT_LINE
 } LineResult;
 
+typedef struct Surface {
+    int num_pts;
+    Vec2D *pts;
+} Surface;
+
+typedef struct Spline {
+    int num_knots;
+    int le_index;
+    float *t;
+    Vec2D *pts;
+    Vec2D *curv;
+} Spline;
+
 typedef struct Airfoil {
     int num_pts;
     int lednicer_index;
+    int capacity;
     char header[MAX_LINE];
-    Vec2D pts[MAX_AIRFOIL_PTS];
+    Vec2D *pts;
+    Surface upper;
+    Surface lower;
+    Spline spline;
     bool has_closed_te;
 } Airfoil;
 
+typedef enum Stage {
+    STAGE_SETUP,
+    STAGE_POINTS,
+    STAGE_INDICES,
+    STAGE_FORMAT,
+    STAGE_WRITE,
+    NUM_STAGES
+} Stage;
+
+typedef struct StageTime {
+    double wall;
+    double cpu;
+} StageTime;
+
+typedef struct Timer {
+    StageTime start;
+    bool is_process;
+} Timer;
+
+typedef struct Stats {
+    StageTime stages[NUM_STAGES];
+    size_t num_pts;
+    size_t num_tris;
+    size_t num_bytes;
+    int num_files;
+} Stats;
+
+typedef void *(*AllocFunc)(size_t size, void *user);
+typedef void (*FreeFunc)(void *ptr, void *user);
+
+typedef struct Allocator {
+    AllocFunc alloc;
+    FreeFunc free;
+    void *user;
+} Allocator;
+
+typedef enum SinkKind {
+    FILE_SINK,
+    STDOUT_SINK,
+    FD_SINK,
+    BUFFER_SINK,
+    MEMORY_SINK
+} SinkKind;
+
+typedef struct Sink {
+    SinkKind kind;
+    int fd;
+    char *target;
+    size_t target_size;
+    size_t target_capacity;
+    const Allocator *allocator;
+} Sink;
+
+typedef struct Writer {
+    Sink sink;
+    char *data;
+    size_t size;
+    size_t capacity;
+    Stats *stats;
+    const uint32_t *crc_table;
+    uint32_t crc;
+} Writer;
+
+typedef struct ZipEntry {
+    const char *name;
+    uint32_t crc;
+    size_t size;
+    size_t offset;
+} ZipEntry;
+
+typedef struct Package {
+    Writer *writer;
+    ZipEntry entries[ZIP_MAX_ENTRIES];
+    int num_entries;
+    uint32_t crc_table[256];
+} Package;
+
+typedef enum SimdLevel {
+    SIMD_NONE,
+    SIMD_SSE,
+    SIMD_AVX
+} SimdLevel;
+
+typedef struct Naca4 {
+    float m, p, t;
+    float a4, p2, b2;
+    bool has_front;
+    bool is_symmetric;
+} Naca4;
+
+typedef struct Profile {
+    int num_pts;
+    float *stations;
+    float *upper_x;
+    float *upper_z;
+    float *lower_x;
+    float *lower_z;
+} Profile;
+
+typedef struct LibraryEntry {
+    int index;
+    int status;
+    char *name;
+    char *path;
+    const char *data;
+    size_t size;
+    Airfoil airfoil;
+} LibraryEntry;
+
+typedef struct Library {
+    char *path;
+    const char *archive;
+    size_t archive_size;
+    int num_entries;
+    int capacity;
+    LibraryEntry *entries;
+} Library;
+
+typedef struct LibraryLoad {
+    Library *library;
+    const char *cache_dir;
+    bool quiet;
+} LibraryLoad;
+
+typedef struct CacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t header_size;
+    uint64_t source_size;
+    int64_t source_mtime;
+    uint64_t source_hash;
+    int32_t num_pts;
+    int32_t lednicer_index;
+    int32_t num_upper;
+    int32_t num_lower;
+    int32_t num_knots;
+    int32_t le_index;
+    int32_t has_closed_te;
+    int32_t path_length;
+    char header[MAX_LINE];
+} CacheHeader;
+
+typedef int (*TaskFunc)(void *context, int itask, int iworker);
+typedef void (*ReportFunc)(void *context, int itask);
+
 typedef struct Settings {
     Units units;
+    Format format;
+    Spacing spacing;
     Airfoil airfoil;
 
+    int decimals;
+    int num_threads;
     int num_slices;
     int num_pts_chord;
 
     float semi_span;
     float root_chord;
     float sweep_angles[2];
+    float tolerance;
 
     bool help;
     bool verbose;
+    bool use_spline;
+    bool stream;
+    bool estimate;
+    bool check_disk;
+
+    int memory_budget;
 
     char *output;
+    char *manifest;
+    char *cache_dir;
+    char *store_dir;
+    char *report;
+    Library library;
 } Settings;
 
+typedef struct PointContext {
+    const Settings *settings;
+    const Profile *profile;
+    Vec3D *pts;
+    int first_col;
+    int num_cols;
+    float tan_le;
+    float tan_te;
+} PointContext;
+
+typedef struct StoreEntry {
+    uint64_t size;
+    uint64_t hash;
+} StoreEntry;
+
+typedef struct SliceContext {
+    const Settings *settings;
+    Settings slice_settings;
+    Profile profile;
+    Vec3D *pts;
+    Vec3D **slice_pts;
+    size_t num_tris;
+    Index *slice_indices;
+    Index **indices;
+    char **names;
+    Writer *writers;
+    Stats *stats;
+    int num_written;
+    char *store;
+    bool *restored;
+    StoreEntry *entries;
+    int num_restored;
+} SliceContext;
+
+typedef struct StoreKey {
+    int32_t version;
+    int32_t units;
+    int32_t format;
+    int32_t spacing;
+    int32_t decimals;
+    int32_t num_slices;
+    int32_t num_pts_chord;
+    int32_t num_airfoil_pts;
+    int32_t lednicer_index;
+    int32_t has_closed_te;
+    int32_t use_spline;
+    float semi_span;
+    float root_chord;
+    float sweep_angles[2];
+    char naca[8];
+} StoreKey;
+
+typedef struct StoreRecord {
+    char magic[4];
+    uint32_t byte_order;
+    uint32_t header_size;
+    int32_t num_entries;
+    StoreKey key;
+} StoreRecord;
+
+typedef struct Estimate {
+    Settings slice_settings;
+    Profile profile;
+    Vec3D *slice_pts;
+    Index *slice_indices;
+    Writer counter;
+    size_t num_tris;
+} Estimate;
+
+typedef struct Job {
+    int line_no;
+    int status;
+    Settings settings;
+} Job;
+
+typedef struct AirfoilCache {
+    int num_airfoils;
+    int capacity;
+    char **keys;
+    Airfoil *airfoils;
+} AirfoilCache;
+
+typedef struct BatchContext {
+    Job *jobs;
+    int num_jobs;
+    int capacity;
+    int num_failed;
+    Writer *writers;
+    Stats *stats;
+    AirfoilCache cache;
+    const Settings *defaults;
+} BatchContext;
+
+typedef struct WingContext {
+    Allocator allocator;
+    Settings settings;
+    Settings slice_settings;
+    Profile profile;
+    Writer writer;
+    Vec3D *pts;
+    Vec3D *slice_pts;
+    Index *indices;
+    Index *slice_indices;
+    size_t num_tris;
+    bool is_ready;
+} WingContext;
+
 #endif
 
 /*
@@ -6,26 +6,47 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <stdint.h>
 #include <stdbool.h>
 #include "types.h"
 
+size_t mul_size(size_t a, size_t b);
 size_t sub2ind(int i, int j, int num_cols);
 
 int num_digits_in(int value);
 
-float interp(Vec2D *p0, Vec2D *p2, float x);
+size_t format_float(char *dst, float value, int decimals);
+size_t format_index(char *dst, size_t value);
+
+float interp(const Vec2D *p0, const Vec2D *p2, float x);
 float to_meters(float value, Units units);
 float to_radians(float degrees);
 
 Units to_units(const char *str);
+Format to_format(const char *str);
+const char *get_format_name(Format format);
+const char *get_format_ext(Format format);
+Spacing to_spacing(const char *str);
+const char *get_spacing_name(Spacing spacing);
+bool is_little_endian(void);
+bool is_indexed(Format format);
 
 void rstrip(char *line);
 void cross(const Vec3D *a, const Vec3D *b, Vec3D *v);
 void subtract(const Vec3D *a, const Vec3D *b, Vec3D *v);
 void normalize(Vec3D *v);
+void *copy_bytes(const void *src, size_t num_bytes);
+uint64_t hash_bytes(const void *data, size_t size, uint64_t hash);
+void put_uint16(unsigned char *dst, uint16_t value);
+void put_uint32(unsigned char *dst, uint32_t value);
+void make_crc_table(uint32_t *table);
+uint32_t update_crc(const uint32_t *table, uint32_t crc, const void *data, size_t size);
+void put_float(unsigned char *dst, float value);
 
 bool nearly_equal(float a, float b);
 bool has_ext(char *arg, const char *ext);
+bool has_mesh_ext(char *arg);
+bool scale_float(float value, int decimals, uint64_t *scaled);
 
 #endif
 
@@ -9,10 +9,11 @@
 #include <stdbool.h>
 #include "types.h"
 
-int validate_airfoil(const Airfoil *airfoil);
+int validate_airfoil(const Airfoil *airfoil, bool quiet);
+int validate_mesh(const Settings *settings);
 int validate_settings(const Settings *settings);
 int validate_file(int num_mid_breaks, int num_quantity_lines, int line_no_invalid,
-                  bool has_break_before_p0, bool has_empty_header); 
+                  bool has_break_before_p0, bool has_empty_header, bool quiet);
 
 void suggest_adjust_values(void);
 void suggest_flag_and_value(const char *desc, const char *flag);
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#ifndef WING_H
+#define WING_H
+
+#include "types.h"
+
+int write_slice(void *context, int islice, int iworker);
+void report_slice(void *context, int islice);
+int write_package(SliceContext *slices);
+void free_workspace(SliceContext *slices, int num_workers);
+int alloc_workspace(SliceContext *slices, const Settings *settings, int num_workers);
+int generate_wing(const Settings *settings, int num_workers, Writer *writers, Stats *stats);
+
+#endif
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
@@ -0,0 +1,442 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#include <stdio.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "wing.h"
+#include "batch.h"
+#include "utils.h"
+#include "types.h"
+#include "sink.h"
+#include "stats.h"
+#include "estimate.h"
+#include "fileio.h"
+#include "engine.h"
+#include "parsing.h"
+#include "spacing.h"
+#include "parallel.h"
+#include "constants.h"
+#include "validation.h"
+
+int split_args(char *line, char **args, int max_args) {
+    int num_args = 0;
+    char *src = line;
+    char *dst = NULL;
+
+    bool is_quoted;
+    bool is_last;
+
+    while (true) {
+        while (isspace((unsigned char) *src)) {
+            src++;
+        }
+
+        if (*src == '\0') {
+            break;
+        }
+
+        if (num_args == max_args) {
+            fprintf(stderr, "wingstl: error: more than %d arguments in manifest job\n", max_args);
+            return -1;
+        }
+
+        dst = src;
+        args[num_args++] = dst;
+        is_quoted = false;
+
+        while (*src != '\0' && (is_quoted || !isspace((unsigned char) *src))) {
+            if (*src == '"') {
+                is_quoted = !is_quoted;
+                src++;
+            } else {
+                *dst++ = *src++;
+            }
+        }
+
+        if (is_quoted) {
+            fprintf(stderr, "wingstl: error: unterminated quote in manifest job\n");
+            return -1;
+        }
+
+        is_last = (*src == '\0');
+        *dst = '\0';
+
+        if (is_last) {
+            break;
+        }
+
+        src++;
+    }
+
+    return num_args;
+}
+
+Airfoil *find_airfoil(AirfoilCache *cache, const char *key) {
+    for (int i = 0; i < cache->num_airfoils; i++) {
+        if (strcmp(cache->keys[i], key) == 0) {
+            return cache->airfoils + i;
+        }
+    }
+
+    return NULL;
+}
+
+Airfoil *load_airfoil(AirfoilCache *cache, const char *key, const Settings *settings) {
+    Airfoil *airfoil = find_airfoil(cache, key);
+
+    if (airfoil != NULL) {
+        return airfoil;
+    }
+
+    if (cache->num_airfoils == cache->capacity) {
+        int capacity = (cache->capacity > 0) ? 2 * cache->capacity : 8;
+
+        char **keys = (char **) realloc(cache->keys, capacity * sizeof(char *));
+
+        if (keys != NULL) {
+            cache->keys = keys;
+        }
+
+        Airfoil *airfoils = (Airfoil *) realloc(cache->airfoils, capacity * sizeof(Airfoil));
+
+        if (airfoils != NULL) {
+            cache->airfoils = airfoils;
+        }
+
+        if (keys == NULL || airfoils == NULL) {
+            fprintf(stderr, "wingstl: error: unable to allocate memory for airfoil cache\n");
+            return NULL;
+        }
+
+        cache->capacity = capacity;
+    }
+
+    char *copy = (char *) malloc((strlen(key) + 1) * sizeof(char));
+
+    if (copy == NULL) {
+        fprintf(stderr, "wingstl: error: unable to allocate memory for airfoil cache\n");
+        return NULL;
+    }
+
+    strcpy(copy, key);
+
+    char *args[] = {FLAG_AIRFOIL, copy};
+
+    airfoil = cache->airfoils + cache->num_airfoils;
+    *airfoil = (Airfoil) {.num_pts = DEFAULT_AIRFOIL};
+
+    handle_airfoil(0, 2, args, airfoil, settings);
+
+    if (airfoil->num_pts < 0) {
+        free_airfoil(airfoil);
+        free(copy);
+
+        return NULL;
+    }
+
+    cache->keys[cache->num_airfoils++] = copy;
+
+    return airfoil;
+}
+
+void free_airfoil_cache(AirfoilCache *cache) {
+    for (int i = 0; i < cache->num_airfoils; i++) {
+        free_airfoil(cache->airfoils + i);
+        free(cache->keys[i]);
+    }
+
+    free(cache->airfoils);
+    free(cache->keys);
+
+    cache->num_airfoils = 0;
+    cache->capacity = 0;
+    cache->airfoils = NULL;
+    cache->keys = NULL;
+}
+
+void free_job(Job *job) {
+    free(job->settings.output);
+    free(job->settings.store_dir);
+
+    job->settings.output = NULL;
+    job->settings.store_dir = NULL;
+}
+
+int add_job(BatchContext *batch, const Job *job) {
+    if (batch->num_jobs == batch->capacity) {
+        int capacity = (batch->capacity > 0) ? 2 * batch->capacity : 16;
+        Job *jobs = (Job *) realloc(batch->jobs, capacity * sizeof(Job));
+
+        if (jobs == NULL) {
+            fprintf(stderr, "wingstl: error: unable to allocate memory for manifest jobs\n");
+            return 1;
+        }
+
+        batch->jobs = jobs;
+        batch->capacity = capacity;
+    }
+
+    batch->jobs[batch->num_jobs++] = *job;
+
+    return 0;
+}
+
+int parse_job(BatchContext *batch, int num_args, char **args, char *line, int line_no) {
+    char *line_args[MAX_JOB_ARGS];
+    char *job_args[2 * MAX_JOB_ARGS + 1];
+
+    int num_line_args = split_args(line, line_args, MAX_JOB_ARGS);
+
+    if (num_line_args < 0 || num_args > MAX_JOB_ARGS) {
+        return 1;
+    }
+
+    int num_job_args = 0;
+    char *airfoil_key = NULL;
+
+    job_args[num_job_args++] = args[0];
+
+    for (int i = 1; i < num_args; i++) {
+        if (strcmp(args[i], FLAG_MANIFEST) == 0 || strcmp(args[i], FLAG_LIBRARY) == 0) {
+            i++;
+        } else if (strcmp(args[i], FLAG_AIRFOIL) == 0 && i + 1 < num_args) {
+            airfoil_key = args[++i];
+        } else {
+            job_args[num_job_args++] = args[i];
+        }
+    }
+
+    for (int i = 0; i < num_line_args; i++) {
+        if (strcmp(line_args[i], FLAG_LIBRARY) == 0) {
+            fprintf(stderr, "wingstl: error: manifest jobs cannot use the flag '%s'\n", FLAG_LIBRARY);
+            return 1;
+        }
+
+        if (strcmp(line_args[i], FLAG_AIRFOIL) == 0 && i + 1 < num_line_args) {
+            airfoil_key = line_args[++i];
+        } else {
+            job_args[num_job_args++] = line_args[i];
+        }
+    }
+
+    Job job = {.line_no = line_no, .status = 0};
+    init_settings(&job.settings);
+    job.settings.library = batch->defaults->library;
+
+    if (handle_inputs(num_job_args, job_args, &job.settings)) {
+        free(job.settings.output);
+        return 1;
+    }
+
+    if (job.settings.store_dir != NULL) {
+        job.settings.store_dir = (char *) copy_bytes(job.settings.store_dir, strlen(job.settings.store_dir) + 1);
+
+        if (job.settings.store_dir == NULL) {
+            fprintf(stderr, "wingstl: error: unable to allocate memory for output cache\n");
+            free(job.settings.output);
+            return 1;
+        }
+    }
+
+    if (job.settings.manifest != NULL) {
+        fprintf(stderr, "wingstl: error: manifest jobs cannot use the flag '%s'\n", FLAG_MANIFEST);
+        free_job(&job);
+        return 1;
+    }
+
+    if (to_sink_kind(job.settings.output) != FILE_SINK) {
+        fprintf(stderr, "wingstl: error: manifest jobs must write to files, not '%s'\n", job.settings.output);
+        free_job(&job);
+        return 1;
+    }
+
+    if (airfoil_key != NULL) {
+        Airfoil *airfoil = load_airfoil(&batch->cache, airfoil_key, &job.settings);
+
+        if (airfoil == NULL) {
+            free_job(&job);
+            return 1;
+        }
+
+        job.settings.airfoil = *airfoil;
+    }
+
+    job.settings.verbose = false;
+    job.settings.num_threads = 1;
+
+    if (validate_settings(&job.settings) || select_chord_pts(&job.settings)) {
+        free_job(&job);
+        return 1;
+    }
+
+    job.settings.cache_dir = NULL;
+    job.settings.report = NULL;
+
+    if (add_job(batch, &job)) {
+        free_job(&job);
+        return 1;
+    }
+
+    return 0;
+}
+
+int read_manifest(const char *fname, int num_args, char **args, BatchContext *batch) {
+    FILE *f = fopen(fname, "r");
+
+    if (f == NULL) {
+        fprintf(stderr, "wingstl: error: unable to open manifest file for reading\n");
+        return 1;
+    }
+
+    char line[MAX_MANIFEST_LINE];
+    char *start = NULL;
+    int line_no = 0;
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        line_no++;
+
+        if (strchr(line, '\n') == NULL && !feof(f)) {
+            fprintf(stderr, "wingstl: error: line %d of manifest file is too long\n", line_no);
+            fclose(f); return 1;
+        }
+
+        rstrip(line);
+        start = line;
+
+        while (isspace((unsigned char) *start)) {
+            start++;
+        }
+
+        if (*start == '\0' || *start == '#') {
+            continue;
+        }
+
+        if (parse_job(batch, num_args, args, start, line_no)) {
+            fprintf(stderr, "wingstl: error: %s:%d: invalid job skipped\n", fname, line_no);
+            batch->num_failed++;
+        }
+    }
+
+    fclose(f);
+
+    return 0;
+}
+
+int run_job(void *context, int ijob, int iworker) {
+    BatchContext *batch = (BatchContext *) context;
+    Job *job = batch->jobs + ijob;
+
+    Stats *stats = (batch->stats == NULL) ? NULL : batch->stats + iworker;
+    job->status = check_budget(&job->settings, 1) || generate_wing(&job->settings, 1, batch->writers + iworker, stats);
+
+    return 0;
+}
+
+void report_job(void *context, int ijob) {
+    BatchContext *batch = (BatchContext *) context;
+    const Job *job = batch->jobs + ijob;
+
+    if (job->status) {
+        fprintf(stderr, "wingstl: error: %s:%d: job failed\n", job->settings.manifest, job->line_no);
+        batch->num_failed++;
+    } else {
+        int num_files = (job->settings.format == THREE_MF) ? 1 : job->settings.num_slices;
+        printf("%s:%d: %d file(s) written\n", job->settings.manifest, job->line_no, num_files);
+    }
+}
+
+void free_batch(BatchContext *batch, int num_workers) {
+    for (int i = 0; i < batch->num_jobs; i++) {
+        free_job(batch->jobs + i);
+    }
+
+    if (batch->writers != NULL) {
+        for (int i = 0; i < num_workers; i++) {
+            free_writer(batch->writers + i);
+        }
+    }
+
+    free(batch->jobs);
+    free(batch->writers);
+    free(batch->stats);
+    free_airfoil_cache(&batch->cache);
+}
+
+int run_batch(const Settings *settings, int num_args, char **args, Stats *stats) {
+    BatchContext batch = {
+        .jobs = NULL, .num_jobs = 0, .capacity = 0, .num_failed = 0, .writers = NULL, .stats = NULL,
+        .cache = {.num_airfoils = 0, .capacity = 0, .keys = NULL, .airfoils = NULL},
+        .defaults = settings
+    };
+
+    if (read_manifest(settings->manifest, num_args, args, &batch)) {
+        free_batch(&batch, 0);
+        return 1;
+    }
+
+    int num_total = batch.num_jobs + batch.num_failed;
+
+    if (num_total == 0) {
+        fprintf(stderr, "wingstl: error: manifest file contains no jobs\n");
+        free_batch(&batch, 0);
+        return 1;
+    }
+
+    for (int i = 0; i < batch.num_jobs; i++) {
+        batch.jobs[i].settings.manifest = settings->manifest;
+    }
+
+    int num_workers = (settings->num_threads < batch.num_jobs) ? settings->num_threads : batch.num_jobs;
+
+    if (num_workers > 0) {
+        batch.writers = (Writer *) calloc(num_workers, sizeof(Writer));
+
+        if (stats != NULL) {
+            batch.stats = (Stats *) calloc(num_workers, sizeof(Stats));
+        }
+
+        if (batch.writers == NULL || (stats != NULL && batch.stats == NULL)) {
+            fprintf(stderr, "wingstl: error: unable to allocate memory for worker buffers\n");
+            free_batch(&batch, 0);
+            return 1;
+        }
+
+        run_parallel(num_workers, batch.num_jobs, run_job, report_job, &batch);
+
+        for (int i = 0; i < num_workers && stats != NULL; i++) {
+            add_stats(stats, batch.stats + i);
+        }
+    }
+
+    printf("%d of %d jobs completed successfully\n", num_total - batch.num_failed, num_total);
+
+    int status = batch.num_failed > 0;
+    free_batch(&batch, num_workers);
+
+    return status;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
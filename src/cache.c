@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include <sys/stat.h>
+
+#include "cache.h"
+#include "utils.h"
+#include "types.h"
+#include "fileio.h"
+#include "engine.h"
+#include "constants.h"
+
+char *make_cache_path(const char *cache_dir, const char *key) {
+    uint64_t hash = hash_bytes(key, strlen(key), FNV_OFFSET);
+    char *path = (char *) malloc((strlen(cache_dir) + strlen(CACHE_EXT) + 18) * sizeof(char));
+
+    if (path != NULL) {
+        sprintf(path, "%s/%016llx%s", cache_dir, (unsigned long long) hash, CACHE_EXT);
+    }
+
+    return path;
+}
+
+int stamp_source(const char *fname, const char *key, CacheHeader *stamp) {
+    struct stat st;
+
+    if (stat(fname, &st) != 0) {
+        return 1;
+    }
+
+    const char *data = NULL;
+    size_t size = 0;
+
+    if (map_file(fname, &data, &size)) {
+        return 1;
+    }
+
+    memset(stamp, 0, sizeof(CacheHeader));
+    memcpy(stamp->magic, CACHE_MAGIC, 4);
+
+    stamp->version = CACHE_VERSION;
+    stamp->byte_order = CACHE_BYTE_ORDER;
+    stamp->header_size = sizeof(CacheHeader);
+    stamp->source_size = (uint64_t) size;
+    stamp->source_mtime = (int64_t) st.st_mtime;
+    stamp->source_hash = hash_bytes(data, size, FNV_OFFSET);
+    stamp->path_length = (int32_t) strlen(key);
+
+    unmap_file(data, size);
+
+    return 0;
+}
+
+size_t get_entry_size(const CacheHeader *header) {
+    size_t num_vecs = (size_t) header->num_pts + header->num_upper + header->num_lower + 2 * (size_t) header->num_knots;
+
+    return sizeof(CacheHeader) + num_vecs * sizeof(Vec2D) + header->num_knots * sizeof(float) + header->path_length;
+}
+
+bool is_entry_valid(const CacheHeader *header, const CacheHeader *stamp, size_t size) {
+    if (size < sizeof(CacheHeader) || memcmp(header->magic, CACHE_MAGIC, 4) != 0) {
+        return false;
+    }
+
+    if (header->version != CACHE_VERSION || header->byte_order != CACHE_BYTE_ORDER || header->header_size != sizeof(CacheHeader)) {
+        return false;
+    }
+
+    if (header->source_size != stamp->source_size || header->source_mtime != stamp->source_mtime ||
+        header->source_hash != stamp->source_hash || header->path_length != stamp->path_length) {
+        return false;
+    }
+
+    if (header->num_pts < 0 || header->num_upper < 0 || header->num_lower < 0 || header->num_knots < 0 ||
+        header->num_upper > header->num_pts || header->num_lower > header->num_pts ||
+        header->num_knots > header->num_upper + header->num_lower || header->header[MAX_LINE - 1] != '\0') {
+        return false;
+    }
+
+    if (header->lednicer_index < 0 || header->lednicer_index > header->num_pts || header->le_index < 0 ||
+        (header->num_knots > 0 && header->le_index >= header->num_knots) || (header->num_knots == 0 && header->le_index != 0)) {
+        return false;
+    }
+
+    return get_entry_size(header) == size;
+}
+
+void *copy_entry_array(const char **src, size_t num_bytes) {
+    void *dst = malloc(num_bytes > 0 ? num_bytes : 1);
+
+    if (dst != NULL) {
+        memcpy(dst, *src, num_bytes);
+    }
+
+    *src += num_bytes;
+    return dst;
+}
+
+int read_cache_entry(const char *path, const char *key, const CacheHeader *stamp, Airfoil *airfoil) {
+    const char *data = NULL;
+    size_t size = 0;
+
+    if (map_file(path, &data, &size)) {
+        return 1;
+    }
+
+    CacheHeader header;
+    memset(&header, 0, sizeof(CacheHeader));
+
+    if (size >= sizeof(CacheHeader)) {
+        memcpy(&header, data, sizeof(CacheHeader));
+    }
+
+    if (!is_entry_valid(&header, stamp, size) ||
+        memcmp(data + size - header.path_length, key, header.path_length) != 0) {
+        unmap_file(data, size);
+        return 1;
+    }
+
+    const char *ptr = data + sizeof(CacheHeader);
+
+    airfoil->pts = (Vec2D *) copy_entry_array(&ptr, header.num_pts * sizeof(Vec2D));
+    airfoil->upper.pts = (Vec2D *) copy_entry_array(&ptr, header.num_upper * sizeof(Vec2D));
+    airfoil->lower.pts = (Vec2D *) copy_entry_array(&ptr, header.num_lower * sizeof(Vec2D));
+    airfoil->spline.t = (float *) copy_entry_array(&ptr, header.num_knots * sizeof(float));
+    airfoil->spline.pts = (Vec2D *) copy_entry_array(&ptr, header.num_knots * sizeof(Vec2D));
+    airfoil->spline.curv = (Vec2D *) copy_entry_array(&ptr, header.num_knots * sizeof(Vec2D));
+
+    unmap_file(data, size);
+
+    if (airfoil->pts == NULL || airfoil->upper.pts == NULL || airfoil->lower.pts == NULL ||
+        airfoil->spline.t == NULL || airfoil->spline.pts == NULL || airfoil->spline.curv == NULL) {
+        free_airfoil(airfoil);
+        return 1;
+    }
+
+    airfoil->num_pts = header.num_pts;
+    airfoil->capacity = header.num_pts;
+    airfoil->lednicer_index = header.lednicer_index;
+    airfoil->has_closed_te = header.has_closed_te;
+    airfoil->upper.num_pts = header.num_upper;
+    airfoil->lower.num_pts = header.num_lower;
+    airfoil->spline.num_knots = header.num_knots;
+    airfoil->spline.le_index = header.le_index;
+    strcpy(airfoil->header, header.header);
+
+    return 0;
+}
+
+int write_cache_entry(const char *path, const char *key, const CacheHeader *stamp, const Airfoil *airfoil) {
+    CacheHeader header = *stamp;
+
+    header.num_pts = airfoil->num_pts;
+    header.lednicer_index = airfoil->lednicer_index;
+    header.num_upper = airfoil->upper.num_pts;
+    header.num_lower = airfoil->lower.num_pts;
+    header.num_knots = airfoil->spline.num_knots;
+    header.le_index = airfoil->spline.le_index;
+    header.has_closed_te = airfoil->has_closed_te;
+    snprintf(header.header, MAX_LINE, "%s", airfoil->header);
+
+    char *temp = (char *) malloc((strlen(path) + 32) * sizeof(char));
+
+    if (temp == NULL) {
+        return 1;
+    }
+
+    sprintf(temp, "%s.%ld.tmp", path, (long) getpid());
+    FILE *f = fopen(temp, "wb");
+
+    if (f == NULL) {
+        free(temp);
+        return 1;
+    }
+
+    bool is_written = fwrite(&header, sizeof(CacheHeader), 1, f) == 1 &&
+        fwrite(airfoil->pts, sizeof(Vec2D), header.num_pts, f) == (size_t) header.num_pts &&
+        fwrite(airfoil->upper.pts, sizeof(Vec2D), header.num_upper, f) == (size_t) header.num_upper &&
+        fwrite(airfoil->lower.pts, sizeof(Vec2D), header.num_lower, f) == (size_t) header.num_lower &&
+        fwrite(airfoil->spline.t, sizeof(float), header.num_knots, f) == (size_t) header.num_knots &&
+        fwrite(airfoil->spline.pts, sizeof(Vec2D), header.num_knots, f) == (size_t) header.num_knots &&
+        fwrite(airfoil->spline.curv, sizeof(Vec2D), header.num_knots, f) == (size_t) header.num_knots &&
+        fwrite(key, 1, header.path_length, f) == (size_t) header.path_length;
+
+    is_written = (fclose(f) == 0) && is_written;
+    is_written = is_written && rename(temp, path) == 0;
+
+    if (!is_written) {
+        remove(temp);
+    }
+
+    free(temp);
+
+    return !is_written;
+}
+
+int load_dat(const char *fname, Airfoil *airfoil, const char *cache_dir, bool quiet) {
+    if (cache_dir == NULL) {
+        return read_dat(fname, airfoil, quiet);
+    }
+
+    char *source = realpath(fname, NULL);
+    const char *key = (source != NULL) ? source : fname;
+
+    CacheHeader stamp;
+    char *path = NULL;
+
+    if (stamp_source(fname, key, &stamp) || (path = make_cache_path(cache_dir, key)) == NULL) {
+        free(source);
+        return read_dat(fname, airfoil, quiet);
+    }
+
+    int status = 0;
+
+    if (read_cache_entry(path, key, &stamp, airfoil)) {
+        status = read_dat(fname, airfoil, quiet);
+        mkdir(cache_dir, 0777);
+
+        if (!status && write_cache_entry(path, key, &stamp, airfoil) && !quiet) {
+            fprintf(stderr, "wingstl: warning: unable to write airfoil cache entry in '%s'\n", cache_dir);
+        }
+    }
+
+    free(source);
+    free(path);
+
+    return status;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
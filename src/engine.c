@@ -14,126 +14,315 @@
 #include "types.h"
 #include "fileio.h"
 #include "engine.h"
+#include "spacing.h"
+#include "parallel.h"
 #include "constants.h"
 
-float get_selig_upper_z(float xc, Airfoil *airfoil) {
-    float x;
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define HAS_X86_SIMD 1
+#endif
 
-    for (int i = 0; i < airfoil->num_pts; i++) {
-        x = airfoil->pts[i].x;
+int find_segment(const Surface *surf, float xc) {
+    int lo = 0;
+    int hi = surf->num_pts;
+    int mid;
 
-        if (nearly_equal(x, xc)) {
-            return airfoil->pts[i].y;
-        }
+    float x;
 
-        if (x < xc) {
-            return interp(airfoil->pts + i, airfoil->pts + i - 1, xc);
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        x = surf->pts[mid].x;
+
+        if (x < xc || nearly_equal(x, xc)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
     }
 
-    return 0.0f;
+    return lo - 1;
 }
 
-float get_selig_lower_z(float xc, Airfoil *airfoil) {
-    int ifinal = airfoil->num_pts - 1;
-    bool missing_point = !nearly_equal(airfoil->pts[0].x, airfoil->pts[ifinal].x);
+float get_dat_z(float xc, const Airfoil *airfoil, bool is_upper) {
+    const Surface *surf = is_upper ? &airfoil->upper : &airfoil->lower;
+    const Surface *other = is_upper ? &airfoil->lower : &airfoil->upper;
+
+    int k = find_segment(surf, xc);
 
-    if (missing_point && nearly_equal(airfoil->pts[0].x, xc)) {
-        return airfoil->pts[0].y;
+    if (k < 0) {
+        return 0.0f;
     }
 
-    float x;
+    const Vec2D *p = surf->pts + k;
 
-    for (int i = airfoil->num_pts - 1; i >= 0; i--) {
-        x = airfoil->pts[i].x;
+    if (nearly_equal(p->x, xc)) {
+        return p->y;
+    }
 
-        if (nearly_equal(x, xc)) {
-            return airfoil->pts[i].y;
-        }
+    if (k < surf->num_pts - 1) {
+        return interp(p, p + 1, xc);
+    }
 
-        if (x < xc) {
-            if (missing_point && i == ifinal) {
-                return interp(airfoil->pts + i, airfoil->pts, xc);
-            }
+    const Vec2D *te = other->pts + other->num_pts - 1;
+    bool missing_point = (te->x > p->x) && !nearly_equal(te->x, p->x);
 
-            return interp(airfoil->pts + i, airfoil->pts + i + 1, xc);
-        }
+    if (missing_point && nearly_equal(te->x, xc)) {
+        return te->y;
     }
 
-    return 0.0f;
+    return missing_point ? interp(p, te, xc) : p->y;
 }
 
-float get_lednicer_upper_z(float xc, Airfoil *airfoil) {
-    float x;
+int make_surfaces(Airfoil *airfoil) {
+    int n = airfoil->num_pts;
+    int li = airfoil->lednicer_index;
 
-    for (int i = 0; i < airfoil->lednicer_index; i++) {
-        x = airfoil->pts[i].x;
+    airfoil->upper.num_pts = 0;
+    airfoil->lower.num_pts = 0;
 
-        if (nearly_equal(x, xc)) {
-            return airfoil->pts[i].y;
-        }
+    if (n <= 0) {
+        return 0;
+    }
 
-        if (x > xc) {
-            if (i == 0) {
-                float x_lower;
+    airfoil->upper.pts = (Vec2D *) malloc(n * sizeof(Vec2D));
+    airfoil->lower.pts = (Vec2D *) malloc(n * sizeof(Vec2D));
 
-                for (int j = airfoil->lednicer_index; j < airfoil->num_pts; j++) {
-                    x_lower = airfoil->pts[j].x;
+    if (airfoil->upper.pts == NULL || airfoil->lower.pts == NULL) {
+        return 1;
+    }
 
-                    if (nearly_equal(x_lower, xc)) {
-                        return airfoil->pts[j].y;
-                    }
+    /* lower surface storage doubles as scratch space for the TE -> LE -> TE loop */
+    Vec2D *loop = airfoil->lower.pts;
 
-                    if (x_lower < xc) {
-                        return interp(airfoil->pts + j, airfoil->pts + j - 1, xc);
-                    }
-                }
-            }
+    for (int k = 0; k < n; k++) {
+        loop[k] = (li > 0 && k < li) ? airfoil->pts[li - 1 - k] : airfoil->pts[k];
+    }
+
+    int ile = 0;
 
-            return interp(airfoil->pts + i - 1, airfoil->pts + i, xc);
+    for (int k = 1; k < n; k++) {
+        if (loop[k].x < loop[ile].x) {
+            ile = k;
         }
     }
 
-    return 0.0f;
+    for (int k = 0; k <= ile; k++) {
+        airfoil->upper.pts[k] = loop[ile - k];
+    }
+
+    for (int k = ile; k < n; k++) {
+        loop[k - ile] = loop[k];
+    }
+
+    airfoil->upper.num_pts = ile + 1;
+    airfoil->lower.num_pts = n - ile;
+
+    return 0;
 }
 
-float get_lednicer_lower_z(float xc, Airfoil *airfoil) {
-    int ifinal = airfoil->num_pts - 1;
-    int iupper_te = airfoil->lednicer_index - 1;
+int make_spline(Airfoil *airfoil) {
+    Spline *spline = &airfoil->spline;
+    const Surface *upper = &airfoil->upper;
+    const Surface *lower = &airfoil->lower;
+
+    int n = 0;
+    bool is_duplicate;
+    Vec2D p;
 
-    bool missing_point = !nearly_equal(airfoil->pts[iupper_te].x, airfoil->pts[ifinal].x);
+    int max_knots = upper->num_pts + lower->num_pts - 1;
 
-    if (missing_point && nearly_equal(airfoil->pts[iupper_te].x, xc)) {
-        return airfoil->pts[iupper_te].y;
+    spline->num_knots = 0;
+    spline->le_index = 0;
+
+    if (max_knots < MIN_AIRFOIL_PTS) {
+        return 0;
     }
 
-    float x;
+    spline->t = (float *) malloc(max_knots * sizeof(float));
+    spline->pts = (Vec2D *) malloc(max_knots * sizeof(Vec2D));
+    spline->curv = (Vec2D *) malloc(max_knots * sizeof(Vec2D));
 
-    for (int i = ifinal; i > iupper_te; i--) {
-        x = airfoil->pts[i].x;
+    float *scratch = (float *) malloc(max_knots * sizeof(float));
 
-        if (nearly_equal(x, xc)) {
-            return airfoil->pts[i].y;
-        }
+    if (spline->t == NULL || spline->pts == NULL || spline->curv == NULL || scratch == NULL) {
+        free(scratch);
+        return 1;
+    }
 
-        if (x < xc) {
-            if (missing_point && i == ifinal) {
-                return interp(airfoil->pts + i, airfoil->pts + iupper_te, xc);
-            }
+    for (int k = upper->num_pts + lower->num_pts - 2; k >= 0; k--) {
+        p = (k >= lower->num_pts) ? upper->pts[k - lower->num_pts + 1] : lower->pts[lower->num_pts - 1 - k];
+
+        is_duplicate = n > 0 && nearly_equal(p.x, spline->pts[n - 1].x) && nearly_equal(p.y, spline->pts[n - 1].y);
+
+        if (k == lower->num_pts - 1) {
+            spline->le_index = is_duplicate ? n - 1 : n;
+        }
 
-            return interp(airfoil->pts + i, airfoil->pts + i + 1, xc);
+        if (!is_duplicate) {
+            spline->pts[n++] = p;
         }
     }
 
-    return 0.0f;
+    if (n < MIN_AIRFOIL_PTS) {
+        free(scratch);
+        return 0;
+    }
+
+    float dx, dy;
+
+    spline->t[0] = 0.0f;
+
+    for (int k = 1; k < n; k++) {
+        dx = spline->pts[k].x - spline->pts[k - 1].x;
+        dy = spline->pts[k].y - spline->pts[k - 1].y;
+        spline->t[k] = spline->t[k - 1] + sqrtf(dx * dx + dy * dy);
+    }
+
+    float h0, h1, w;
+    Vec2D *m = spline->curv;
+
+    m[0].x = m[0].y = 0.0f;
+    scratch[0] = 0.0f;
+
+    for (int k = 1; k < n - 1; k++) {
+        h0 = spline->t[k] - spline->t[k - 1];
+        h1 = spline->t[k + 1] - spline->t[k];
+        w = 2.0f * (h0 + h1) - h0 * scratch[k - 1];
+
+        scratch[k] = h1 / w;
+        m[k].x = (6.0f * ((spline->pts[k + 1].x - spline->pts[k].x) / h1 -
+                          (spline->pts[k].x - spline->pts[k - 1].x) / h0) - h0 * m[k - 1].x) / w;
+        m[k].y = (6.0f * ((spline->pts[k + 1].y - spline->pts[k].y) / h1 -
+                          (spline->pts[k].y - spline->pts[k - 1].y) / h0) - h0 * m[k - 1].y) / w;
+    }
+
+    m[n - 1].x = m[n - 1].y = 0.0f;
+
+    for (int k = n - 2; k > 0; k--) {
+        m[k].x -= scratch[k] * m[k + 1].x;
+        m[k].y -= scratch[k] * m[k + 1].y;
+    }
+
+    spline->num_knots = n;
+    free(scratch);
+
+    return 0;
+}
+
+int copy_airfoil(Airfoil *dst, const Airfoil *src) {
+    *dst = *src;
+    dst->capacity = src->num_pts;
+
+    dst->pts = (Vec2D *) copy_bytes(src->pts, src->num_pts * sizeof(Vec2D));
+    dst->upper.pts = (Vec2D *) copy_bytes(src->upper.pts, src->upper.num_pts * sizeof(Vec2D));
+    dst->lower.pts = (Vec2D *) copy_bytes(src->lower.pts, src->lower.num_pts * sizeof(Vec2D));
+    dst->spline.t = (float *) copy_bytes(src->spline.t, src->spline.num_knots * sizeof(float));
+    dst->spline.pts = (Vec2D *) copy_bytes(src->spline.pts, src->spline.num_knots * sizeof(Vec2D));
+    dst->spline.curv = (Vec2D *) copy_bytes(src->spline.curv, src->spline.num_knots * sizeof(Vec2D));
+
+    if (dst->pts == NULL || dst->upper.pts == NULL || dst->lower.pts == NULL ||
+        dst->spline.t == NULL || dst->spline.pts == NULL || dst->spline.curv == NULL) {
+        free_airfoil(dst);
+        return 1;
+    }
+
+    return 0;
 }
 
-float get_lednicer_z(float xc, Airfoil *airfoil, bool is_upper) {
-    return is_upper ? get_lednicer_upper_z(xc, airfoil) : get_lednicer_lower_z(xc, airfoil);
+void free_airfoil(Airfoil *airfoil) {
+    free(airfoil->pts);
+    free(airfoil->upper.pts);
+    free(airfoil->lower.pts);
+    free(airfoil->spline.t);
+    free(airfoil->spline.pts);
+    free(airfoil->spline.curv);
+
+    airfoil->pts = NULL;
+    airfoil->upper.pts = NULL;
+    airfoil->lower.pts = NULL;
+    airfoil->spline.t = NULL;
+    airfoil->spline.pts = NULL;
+    airfoil->spline.curv = NULL;
+
+    airfoil->capacity = 0;
+    airfoil->upper.num_pts = 0;
+    airfoil->lower.num_pts = 0;
+    airfoil->spline.num_knots = 0;
 }
 
-float get_selig_z(float xc, Airfoil *airfoil, bool is_upper) {
-    return is_upper ? get_selig_upper_z(xc, airfoil) : get_selig_lower_z(xc, airfoil);
+void eval_spline(const Spline *spline, int k, float t, Vec2D *p) {
+    float h = spline->t[k + 1] - spline->t[k];
+    float a = (spline->t[k + 1] - t) / h;
+    float b = 1.0f - a;
+    float ca = (a * a * a - a) * h * h / 6.0f;
+    float cb = (b * b * b - b) * h * h / 6.0f;
+
+    p->x = a * spline->pts[k].x + b * spline->pts[k + 1].x + ca * spline->curv[k].x + cb * spline->curv[k + 1].x;
+    p->y = a * spline->pts[k].y + b * spline->pts[k + 1].y + ca * spline->curv[k].y + cb * spline->curv[k + 1].y;
+}
+
+float get_spline_z(float xc, const Airfoil *airfoil, bool is_upper) {
+    const Spline *spline = &airfoil->spline;
+
+    if (spline->num_knots < MIN_AIRFOIL_PTS) {
+        return get_dat_z(xc, airfoil, is_upper);
+    }
+
+    int ile = spline->le_index;
+    int count = is_upper ? ile + 1 : spline->num_knots - ile;
+    int sign = is_upper ? -1 : 1;
+
+    int lo = 0;
+    int hi = count;
+    int mid;
+
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+
+        if (spline->pts[ile + sign * mid].x <= xc) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    int m = lo - 1;
+
+    if (m < 0 || m >= count - 1) {
+        return get_dat_z(xc, airfoil, is_upper);
+    }
+
+    if (nearly_equal(spline->pts[ile + sign * m].x, xc)) {
+        return spline->pts[ile + sign * m].y;
+    }
+
+    int k = is_upper ? ile - m - 1 : ile + m;
+    float t0 = spline->t[k];
+    float t1 = spline->t[k + 1];
+    float f0 = spline->pts[k].x - xc;
+    float t = t0;
+
+    Vec2D p;
+
+    for (int iter = 0; iter < MAX_SPLINE_ITERS; iter++) {
+        t = 0.5f * (t0 + t1);
+        eval_spline(spline, k, t, &p);
+
+        if ((p.x - xc > 0.0f) == (f0 > 0.0f)) {
+            t0 = t;
+        } else {
+            t1 = t;
+        }
+
+        if (t1 - t0 <= FLT_EPSILON * t1) {
+            break;
+        }
+    }
+
+    eval_spline(spline, k, t, &p);
+
+    return p.y;
 }
 
 float get_naca4_camber(float x, float m, float p) {
@@ -180,32 +369,34 @@ float get_naca4_surface_z(float zc, float thickness, float theta, bool is_upper)
     return zc + sign * thickness * cosf(theta);
 }
 
-float get_surface_x(float xn_camber, Airfoil *airfoil, bool is_upper) {
+void get_naca4_params(const Airfoil *airfoil, float *m, float *p, float *t) {
+    *m = (airfoil->header[0] - '0') / 100.0f;
+    *p = (airfoil->header[1] - '0') / 10.0f;
+    *t = atoi(airfoil->header + 2) / 100.0f;
+}
+
+float get_surface_x(float xn_camber, const Airfoil *airfoil, bool is_upper) {
     if (airfoil->num_pts > 0) {
         return xn_camber;
     }
 
-    float m = (airfoil->header[0] - '0') / 100.0f;
-    float p = (airfoil->header[1] - '0') / 10.0f;
-    float t = atoi(airfoil->header + 2) / 100.0f;
+    float m, p, t;
+    get_naca4_params(airfoil, &m, &p, &t);
+
     float theta = get_naca4_gradient(xn_camber, m, p);
     float thickness = get_naca4_thickness(xn_camber, t, airfoil->has_closed_te);
 
     return get_naca4_surface_x(xn_camber, thickness, theta, is_upper);
 }
 
-float get_surface_z(float xn_camber, Airfoil *airfoil, bool is_upper) {
-    if (airfoil->num_pts > 0 && airfoil->lednicer_index > 0) {
-        return get_lednicer_z(xn_camber, airfoil, is_upper);
+float get_surface_z(float xn_camber, const Airfoil *airfoil, bool is_upper) {
+    if (airfoil->num_pts > 0) {
+        return get_dat_z(xn_camber, airfoil, is_upper);
     }
 
-    if (airfoil->num_pts > 0 && airfoil->lednicer_index == 0) {
-        return get_selig_z(xn_camber, airfoil, is_upper);
-    }
+    float m, p, t;
+    get_naca4_params(airfoil, &m, &p, &t);
 
-    float m = (airfoil->header[0] - '0') / 100.0f;
-    float p = (airfoil->header[1] - '0') / 10.0f;
-    float t = atoi(airfoil->header + 2) / 100.0f;
     float theta = get_naca4_gradient(xn_camber, m, p);
     float thickness = get_naca4_thickness(xn_camber, t, airfoil->has_closed_te);
     float zn_camber = get_naca4_camber(xn_camber, m, p);
@@ -213,77 +404,420 @@ float get_surface_z(float xn_camber, Airfoil *airfoil, bool is_upper) {
     return get_naca4_surface_z(zn_camber, thickness, theta, is_upper);
 }
 
+void naca4_section_scalar(const float *x, int istart, int n, const Naca4 *naca,
+                          float *thickness, float *zn_camber, float *theta) {
+    float x2, a, g;
+    bool is_front;
+
+    for (int i = istart; i < n; i++) {
+        x2 = x[i] * x[i];
+        thickness[i] = (A0 * powf(x[i], 0.5f) + A1 * x[i] + A2 * x2 +
+                        A3 * x2 * x[i] + naca->a4 * x2 * x2) * naca->t / 0.2f;
+
+        if (naca->is_symmetric) {
+            continue;
+        }
+
+        is_front = x[i] < naca->p && naca->has_front;
+        a = 2.0f * naca->p * x[i] - x[i] * x[i];
+        g = (2.0f * naca->m) * (naca->p - x[i]);
+
+        zn_camber[i] = is_front ? naca->m * a / naca->p2 : naca->m * (1.0f - 2.0f * naca->p + a) / naca->b2;
+        theta[i] = is_front ? g / naca->p2 : g / naca->b2;
+    }
+}
+
+void naca4_surface_scalar(const float *x, int istart, int n, float *xu, float *zu, float *xl, float *zl) {
+    float thickness, zn_camber, sin_theta, cos_theta;
+
+    for (int i = istart; i < n; i++) {
+        thickness = zu[i];
+        zn_camber = zl[i];
+        sin_theta = xl[i];
+        cos_theta = xu[i];
+
+        xu[i] = x[i] - thickness * sin_theta;
+        xl[i] = x[i] + thickness * sin_theta;
+        zu[i] = zn_camber + thickness * cos_theta;
+        zl[i] = zn_camber - thickness * cos_theta;
+    }
+}
+
+#ifdef HAS_X86_SIMD
+int naca4_section_sse(const float *x, int n, const Naca4 *naca,
+                      float *thickness, float *zn_camber, float *theta) {
+    __m128 a0 = _mm_set1_ps(A0), a1 = _mm_set1_ps(A1), a2 = _mm_set1_ps(A2);
+    __m128 a3 = _mm_set1_ps(A3), a4 = _mm_set1_ps(naca->a4);
+    __m128 t = _mm_set1_ps(naca->t), fifth = _mm_set1_ps(0.2f);
+    __m128 m = _mm_set1_ps(naca->m), p = _mm_set1_ps(naca->p), two_p = _mm_set1_ps(2.0f * naca->p);
+    __m128 two_m = _mm_set1_ps(2.0f * naca->m), one_minus_2p = _mm_set1_ps(1.0f - 2.0f * naca->p);
+    __m128 p2 = _mm_set1_ps(naca->p2), b2 = _mm_set1_ps(naca->b2);
+    __m128 front = naca->has_front ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : _mm_setzero_ps();
+    __m128 xi, x2, y, a, g, mask;
+
+    int i = 0;
+
+    for (int k = 0; k < n - n % 4; k++) {
+        thickness[k] = powf(x[k], 0.5f);
+    }
+
+    for (; i + 4 <= n; i += 4) {
+        xi = _mm_loadu_ps(x + i);
+        x2 = _mm_mul_ps(xi, xi);
+        y = _mm_add_ps(_mm_mul_ps(a0, _mm_loadu_ps(thickness + i)), _mm_mul_ps(a1, xi));
+        y = _mm_add_ps(y, _mm_mul_ps(a2, x2));
+        y = _mm_add_ps(y, _mm_mul_ps(_mm_mul_ps(a3, x2), xi));
+        y = _mm_add_ps(y, _mm_mul_ps(_mm_mul_ps(a4, x2), x2));
+        _mm_storeu_ps(thickness + i, _mm_div_ps(_mm_mul_ps(y, t), fifth));
+
+        if (naca->is_symmetric) {
+            continue;
+        }
+
+        mask = _mm_and_ps(_mm_cmplt_ps(xi, p), front);
+        a = _mm_sub_ps(_mm_mul_ps(two_p, xi), x2);
+        g = _mm_mul_ps(two_m, _mm_sub_ps(p, xi));
+
+        y = _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(_mm_mul_ps(m, a), p2)),
+                      _mm_andnot_ps(mask, _mm_div_ps(_mm_mul_ps(m, _mm_add_ps(one_minus_2p, a)), b2)));
+        _mm_storeu_ps(zn_camber + i, y);
+
+        y = _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(g, p2)), _mm_andnot_ps(mask, _mm_div_ps(g, b2)));
+        _mm_storeu_ps(theta + i, y);
+    }
+
+    return i;
+}
+
+int naca4_surface_sse(const float *x, int n, float *xu, float *zu, float *xl, float *zl) {
+    __m128 xi, thickness, zn_camber, ts, tc;
+
+    int i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        xi = _mm_loadu_ps(x + i);
+        thickness = _mm_loadu_ps(zu + i);
+        zn_camber = _mm_loadu_ps(zl + i);
+        ts = _mm_mul_ps(thickness, _mm_loadu_ps(xl + i));
+        tc = _mm_mul_ps(thickness, _mm_loadu_ps(xu + i));
+
+        _mm_storeu_ps(xu + i, _mm_sub_ps(xi, ts));
+        _mm_storeu_ps(xl + i, _mm_add_ps(xi, ts));
+        _mm_storeu_ps(zu + i, _mm_add_ps(zn_camber, tc));
+        _mm_storeu_ps(zl + i, _mm_sub_ps(zn_camber, tc));
+    }
+
+    return i;
+}
+
+__attribute__((target("avx")))
+int naca4_section_avx(const float *x, int n, const Naca4 *naca,
+                      float *thickness, float *zn_camber, float *theta) {
+    __m256 a0 = _mm256_set1_ps(A0), a1 = _mm256_set1_ps(A1), a2 = _mm256_set1_ps(A2);
+    __m256 a3 = _mm256_set1_ps(A3), a4 = _mm256_set1_ps(naca->a4);
+    __m256 t = _mm256_set1_ps(naca->t), fifth = _mm256_set1_ps(0.2f);
+    __m256 m = _mm256_set1_ps(naca->m), p = _mm256_set1_ps(naca->p), two_p = _mm256_set1_ps(2.0f * naca->p);
+    __m256 two_m = _mm256_set1_ps(2.0f * naca->m), one_minus_2p = _mm256_set1_ps(1.0f - 2.0f * naca->p);
+    __m256 p2 = _mm256_set1_ps(naca->p2), b2 = _mm256_set1_ps(naca->b2);
+    __m256 front = naca->has_front ? _mm256_castsi256_ps(_mm256_set1_epi32(-1)) : _mm256_setzero_ps();
+    __m256 xi, x2, y, a, g, mask;
+
+    int i = 0;
+
+    for (int k = 0; k < n - n % 8; k++) {
+        thickness[k] = powf(x[k], 0.5f);
+    }
+
+    for (; i + 8 <= n; i += 8) {
+        xi = _mm256_loadu_ps(x + i);
+        x2 = _mm256_mul_ps(xi, xi);
+        y = _mm256_add_ps(_mm256_mul_ps(a0, _mm256_loadu_ps(thickness + i)), _mm256_mul_ps(a1, xi));
+        y = _mm256_add_ps(y, _mm256_mul_ps(a2, x2));
+        y = _mm256_add_ps(y, _mm256_mul_ps(_mm256_mul_ps(a3, x2), xi));
+        y = _mm256_add_ps(y, _mm256_mul_ps(_mm256_mul_ps(a4, x2), x2));
+        _mm256_storeu_ps(thickness + i, _mm256_div_ps(_mm256_mul_ps(y, t), fifth));
+
+        if (naca->is_symmetric) {
+            continue;
+        }
+
+        mask = _mm256_and_ps(_mm256_cmp_ps(xi, p, _CMP_LT_OQ), front);
+        a = _mm256_sub_ps(_mm256_mul_ps(two_p, xi), x2);
+        g = _mm256_mul_ps(two_m, _mm256_sub_ps(p, xi));
+
+        y = _mm256_blendv_ps(_mm256_div_ps(_mm256_mul_ps(m, _mm256_add_ps(one_minus_2p, a)), b2),
+                             _mm256_div_ps(_mm256_mul_ps(m, a), p2), mask);
+        _mm256_storeu_ps(zn_camber + i, y);
+
+        y = _mm256_blendv_ps(_mm256_div_ps(g, b2), _mm256_div_ps(g, p2), mask);
+        _mm256_storeu_ps(theta + i, y);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx")))
+int naca4_surface_avx(const float *x, int n, float *xu, float *zu, float *xl, float *zl) {
+    __m256 xi, thickness, zn_camber, ts, tc;
+
+    int i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        xi = _mm256_loadu_ps(x + i);
+        thickness = _mm256_loadu_ps(zu + i);
+        zn_camber = _mm256_loadu_ps(zl + i);
+        ts = _mm256_mul_ps(thickness, _mm256_loadu_ps(xl + i));
+        tc = _mm256_mul_ps(thickness, _mm256_loadu_ps(xu + i));
+
+        _mm256_storeu_ps(xu + i, _mm256_sub_ps(xi, ts));
+        _mm256_storeu_ps(xl + i, _mm256_add_ps(xi, ts));
+        _mm256_storeu_ps(zu + i, _mm256_add_ps(zn_camber, tc));
+        _mm256_storeu_ps(zl + i, _mm256_sub_ps(zn_camber, tc));
+    }
+
+    return i;
+}
+#endif
+
+SimdLevel get_simd_level(void) {
+#ifdef HAS_X86_SIMD
+    return __builtin_cpu_supports("avx") ? SIMD_AVX : SIMD_SSE;
+#else
+    return SIMD_NONE;
+#endif
+}
+
+void get_naca4_batch(const float *x, int n, const Airfoil *airfoil, SimdLevel level,
+                     float *xu, float *zu, float *xl, float *zl) {
+    Naca4 naca;
+    get_naca4_params(airfoil, &naca.m, &naca.p, &naca.t);
+
+    naca.a4 = airfoil->has_closed_te ? A4_CLOSED : A4_OPEN;
+    naca.p2 = naca.p * naca.p;
+    naca.b2 = (1.0f - naca.p) * (1.0f - naca.p);
+    naca.has_front = naca.p > FLT_EPSILON;
+    naca.is_symmetric = (airfoil->header[0] == '0');
+
+    int i = 0;
+
+#ifdef HAS_X86_SIMD
+    if (level == SIMD_AVX) {
+        i = naca4_section_avx(x, n, &naca, zu, zl, xu);
+    } else if (level == SIMD_SSE) {
+        i = naca4_section_sse(x, n, &naca, zu, zl, xu);
+    }
+#endif
+
+    naca4_section_scalar(x, i, n, &naca, zu, zl, xu);
+
+    if (naca.is_symmetric) {
+        for (i = 0; i < n; i++) {
+            xu[i] = x[i];
+            xl[i] = x[i];
+            zl[i] = -zu[i];
+        }
+
+        return;
+    }
+
+    for (i = 0; i < n; i++) {
+        xl[i] = sinf(xu[i]);
+        xu[i] = cosf(xu[i]);
+    }
+
+    i = 0;
+
+#ifdef HAS_X86_SIMD
+    if (level == SIMD_AVX) {
+        i = naca4_surface_avx(x, n, xu, zu, xl, zl);
+    } else if (level == SIMD_SSE) {
+        i = naca4_surface_sse(x, n, xu, zu, xl, zl);
+    }
+#endif
+
+    naca4_surface_scalar(x, i, n, xu, zu, xl, zl);
+}
+
+void fill_dat_profile(const Airfoil *airfoil, Profile *profile, bool use_spline) {
+    float x;
+
+    for (int i = 0; i < profile->num_pts; i++) {
+        x = profile->stations[i];
+
+        profile->upper_x[i] = x;
+        profile->lower_x[i] = x;
+
+        if (use_spline) {
+            profile->upper_z[i] = get_spline_z(x, airfoil, true);
+            profile->lower_z[i] = get_spline_z(x, airfoil, false);
+        } else {
+            profile->upper_z[i] = get_surface_z(x, airfoil, true);
+            profile->lower_z[i] = get_surface_z(x, airfoil, false);
+        }
+    }
+}
+
+void free_profile(Profile *profile) {
+    free(profile->stations);
+    free(profile->upper_x);
+    free(profile->upper_z);
+    free(profile->lower_x);
+    free(profile->lower_z);
+
+    profile->stations = NULL;
+    profile->upper_x = NULL;
+    profile->upper_z = NULL;
+    profile->lower_x = NULL;
+    profile->lower_z = NULL;
+}
+
+int make_profile(const Settings *settings, Profile *profile) {
+    int n = settings->num_pts_chord;
+
+    profile->num_pts = n;
+    profile->stations = (float *) malloc(n * sizeof(float));
+    profile->upper_x = (float *) malloc(n * sizeof(float));
+    profile->upper_z = (float *) malloc(n * sizeof(float));
+    profile->lower_x = (float *) malloc(n * sizeof(float));
+    profile->lower_z = (float *) malloc(n * sizeof(float));
+
+    if (profile->stations == NULL || profile->upper_x == NULL || profile->upper_z == NULL ||
+        profile->lower_x == NULL || profile->lower_z == NULL) {
+        free_profile(profile);
+        return 1;
+    }
+
+    if (fill_stations(settings, profile->stations, n)) {
+        free_profile(profile);
+        return 1;
+    }
+
+    if (settings->airfoil.num_pts > 0) {
+        fill_dat_profile(&settings->airfoil, profile, settings->use_spline);
+    } else {
+        get_naca4_batch(profile->stations, n, &settings->airfoil, get_simd_level(),
+                        profile->upper_x, profile->upper_z, profile->lower_x, profile->lower_z);
+    }
+
+    return 0;
+}
+
+size_t get_num_col_pts(const Settings *settings) {
+    return 2 * (size_t) settings->num_pts_chord - settings->airfoil.has_closed_te - 1;
+}
+
 size_t get_num_pts(const Settings *settings) {
-    return (size_t) (settings->num_slices + 1) * (2 * settings->num_pts_chord - 
-                     settings->airfoil.has_closed_te - 1);
+    return mul_size((size_t) settings->num_slices + 1, get_num_col_pts(settings));
 }
 
 size_t get_num_tris(const Settings *settings) {
-    size_t num_tris_surf = (settings->num_pts_chord - 1) * 2;
-    size_t num_tris_side = 2 * settings->num_pts_chord - settings->airfoil.has_closed_te - 3;
+    size_t num_tris_surf = ((size_t) settings->num_pts_chord - 1) * 2;
+    size_t num_tris_side = 2 * (size_t) settings->num_pts_chord - settings->airfoil.has_closed_te - 3;
     size_t num_tris_aft = !settings->airfoil.has_closed_te * 2;
     
     return 2 * (num_tris_surf + num_tris_side) + num_tris_aft;
 }
 
-Vec3D *make_pts(Settings *settings) {
-    Vec3D *pts = (Vec3D *) malloc(get_num_pts(settings) * sizeof(Vec3D));
+int fill_row(void *context, int i, int iworker) {
+    PointContext *grid = (PointContext *) context;
+    const Settings *settings = grid->settings;
+
+    (void) iworker;
 
-    if (pts == NULL) {
-        return NULL;
-    }
-    
     float dx_te;
     float dx_le;
     float xn_surf;
     float zn_surf;
     float y_camber;
-    float xn_camber;
     float local_chord;
 
-    int row_max = settings->num_pts_chord;
+    int j;
     int num_rows = settings->num_pts_chord;
-    int num_cols = settings->num_slices + 1;
-    int row_start = 0;
-
-    float tan_le = tanf(to_radians(90.0f - settings->sweep_angles[0]));
-    float tan_te = tanf(to_radians(90.0f - settings->sweep_angles[1]));
+    int num_cols = grid->num_cols;
 
     size_t ind;
 
     for (int is_upper = 1; is_upper >= 0; is_upper--) {
-        if (!is_upper) {
-            row_start = 1;
-            row_max = num_rows - settings->airfoil.has_closed_te;
+        if (!is_upper && (i == 0 || i >= num_rows - settings->airfoil.has_closed_te)) {
+            continue;
         }
 
-        for (int j = 0; j < num_cols; j++) {
-            y_camber = settings->semi_span * j / (num_cols - 1);
-            dx_te = y_camber * tan_te;
-            dx_le = y_camber * tan_le;
-            local_chord = settings->root_chord + dx_te - dx_le;
+        xn_surf = is_upper ? grid->profile->upper_x[i] : grid->profile->lower_x[i];
+        zn_surf = is_upper ? grid->profile->upper_z[i] : grid->profile->lower_z[i];
 
-            for (int i = row_start; i < row_max; i++) {
-                if (is_upper) {
-                    ind = sub2ind(i - row_start, j, num_cols);
-                } else {
-                    ind = (size_t) num_rows * num_cols + sub2ind(i - row_start, j, num_cols);
-                }
-
-                xn_camber = (1.0f - cosf(((float) i / (num_rows - 1)) * PI)) / 2.0f;
-                xn_surf = get_surface_x(xn_camber, &settings->airfoil, is_upper);
-                zn_surf = get_surface_z(xn_camber, &settings->airfoil, is_upper);
+        for (int col = 0; col < num_cols; col++) {
+            j = grid->first_col + col;
+            y_camber = settings->semi_span * j / settings->num_slices;
+            dx_te = y_camber * grid->tan_te;
+            dx_le = y_camber * grid->tan_le;
+            local_chord = settings->root_chord + dx_te - dx_le;
 
-                pts[ind].y = to_meters(y_camber, settings->units);
-                pts[ind].z = to_meters(zn_surf * local_chord, settings->units);
-                pts[ind].x = to_meters(xn_surf * local_chord + dx_le, settings->units);
+            if (is_upper) {
+                ind = sub2ind(i, col, num_cols);
+            } else {
+                ind = (size_t) num_rows * num_cols + sub2ind(i - 1, col, num_cols);
             }
+
+            grid->pts[ind].y = to_meters(y_camber, settings->units);
+            grid->pts[ind].z = to_meters(zn_surf * local_chord, settings->units);
+            grid->pts[ind].x = to_meters(xn_surf * local_chord + dx_le, settings->units);
         }
     }
 
+    return 0;
+}
+
+void init_grid(const Settings *settings, const Profile *profile, Vec3D *pts, int first_col, int num_cols, PointContext *grid) {
+    grid->settings = settings;
+    grid->profile = profile;
+    grid->pts = pts;
+    grid->first_col = first_col;
+    grid->num_cols = num_cols;
+    grid->tan_le = tanf(to_radians(90.0f - settings->sweep_angles[0]));
+    grid->tan_te = tanf(to_radians(90.0f - settings->sweep_angles[1]));
+}
+
+int fill_pts(const Settings *settings, Vec3D *pts) {
+    Profile profile;
+
+    if (make_profile(settings, &profile)) {
+        return 1;
+    }
+
+    PointContext grid;
+    init_grid(settings, &profile, pts, 0, settings->num_slices + 1, &grid);
+
+    int status = run_parallel(settings->num_threads, settings->num_pts_chord, fill_row, NULL, &grid);
+    free_profile(&profile);
+
+    return status;
+}
+
+Vec3D *make_pts(const Settings *settings) {
+    Vec3D *pts = (Vec3D *) malloc(get_num_pts(settings) * sizeof(Vec3D));
+
+    if (pts != NULL && fill_pts(settings, pts)) {
+        free(pts);
+        return NULL;
+    }
+
     return pts;
 }
 
+void make_slice_pts(const Settings *settings, const Profile *profile, int islice, Vec3D *pts) {
+    PointContext grid;
+    init_grid(settings, profile, pts, islice, 2, &grid);
+
+    for (int i = 0; i < settings->num_pts_chord; i++) {
+        fill_row(&grid, i, 0);
+    }
+}
+
+void make_slice_settings(const Settings *settings, Settings *slice_settings) {
+    *slice_settings = *settings;
+    slice_settings->num_slices = 1;
+}
+
 size_t get_upper_index(const Settings *settings, int i, int j) {
     return sub2ind(i, j, settings->num_slices + 1);
 }
@@ -299,8 +833,8 @@ size_t get_lower_index(const Settings *settings, int i, int j) {
     return (size_t) settings->num_pts_chord * (settings->num_slices + 1) + offset;
 }
 
-size_t fill_upper_lower_indices(const Settings *settings, size_t k, size_t *inds, int islice) {
-    size_t corners[4];
+size_t fill_upper_lower_indices(const Settings *settings, size_t k, Index *inds, int islice) {
+    Index corners[4];
 
     int j = islice;
     for (int is_upper = 1; is_upper >= 0; is_upper--) {
@@ -329,10 +863,10 @@ size_t fill_upper_lower_indices(const Settings *settings, size_t k, size_t *inds
     return k;
 }
 
-size_t fill_port_star_indices(const Settings *settings, size_t k, size_t *inds, int islice) {
+size_t fill_port_star_indices(const Settings *settings, size_t k, Index *inds, int islice) {
     int j;
     bool is_last_row;
-    size_t corners[4];
+    Index corners[4];
 
     for (int is_port = 1; is_port >= 0; is_port--) { 
         j = is_port ? islice : islice + 1;
@@ -386,11 +920,11 @@ size_t fill_port_star_indices(const Settings *settings, size_t k, size_t *inds,
     return k;
 }
 
-size_t fill_aft_indices(const Settings *settings, size_t k, size_t *inds, int islice) {
+size_t fill_aft_indices(const Settings *settings, size_t k, Index *inds, int islice) {
     int i = settings->num_pts_chord - 1;
     int j = islice;
 
-    size_t corners[4];
+    Index corners[4];
 
     corners[0] = get_lower_index(settings, i, j);
     corners[1] = get_lower_index(settings, i, j + 1);
@@ -407,7 +941,7 @@ size_t fill_aft_indices(const Settings *settings, size_t k, size_t *inds, int is
     return k;
 }
 
-void assign_indices(const Settings *settings, size_t num_tris, int islice, size_t *indices) {
+void assign_indices(const Settings *settings, size_t num_tris, int islice, Index *indices) {
     size_t k = 0;
 
     k = fill_upper_lower_indices(settings, k, indices, islice);
@@ -428,6 +962,14 @@ float get_surface_area(const Settings *settings) {
     return 2.0f * settings->root_chord * settings->semi_span + settings->semi_span * (dx_te - dx_le);
 }
 
+float get_max_chord(const Settings *settings) {
+    float dx_le = settings->semi_span * tanf(to_radians(90.0f - settings->sweep_angles[0]));
+    float dx_te = settings->semi_span * tanf(to_radians(90.0f - settings->sweep_angles[1]));
+    float tip_chord = settings->root_chord + dx_te - dx_le;
+
+    return (tip_chord > settings->root_chord) ? tip_chord : settings->root_chord;
+}
+
 float get_aspect_ratio(const Settings *settings) {
     float s = get_surface_area(settings);
     float b = 2.0f * settings->semi_span;
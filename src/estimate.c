@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include <sys/statvfs.h>
+
+#include "sink.h"
+#include "utils.h"
+#include "types.h"
+#include "fileio.h"
+#include "engine.h"
+#include "threemf.h"
+#include "estimate.h"
+#include "constants.h"
+
+size_t get_fixed_bytes(Format format, size_t num_pts, size_t num_tris) {
+    char header[MAX_HEADER_CHARS];
+
+    switch (format) {
+        case BINARY_STL:
+            return STL_HEADER_SIZE + 4 + STL_FACET_SIZE * num_tris;
+        case BINARY_PLY:
+            return (size_t) format_ply_header(header, num_pts, num_tris) + PLY_VERTEX_SIZE * num_pts + PLY_FACE_SIZE * num_tris;
+        default:
+            return 0;
+    }
+}
+
+size_t get_memory_estimate(const Settings *settings, int num_workers) {
+    const Airfoil *airfoil = &settings->airfoil;
+
+    size_t num_tris = get_num_tris(settings);
+    size_t index_bytes = 3 * num_tris * sizeof(Index);
+    size_t num_bytes = (size_t) num_workers * (WRITE_BUFFER_SIZE + get_name_length(settings));
+
+    num_bytes += 5 * (size_t) settings->num_pts_chord * sizeof(float);
+
+    if (airfoil->num_pts > 0) {
+        num_bytes += (size_t) airfoil->capacity * sizeof(Vec2D);
+        num_bytes += (size_t) airfoil->num_pts * (2 * sizeof(Vec2D) + sizeof(float) + sizeof(Vec2D));
+    }
+
+    if (settings->stream || is_indexed(settings->format)) {
+        Settings slice_settings;
+        make_slice_settings(settings, &slice_settings);
+
+        num_bytes += (size_t) num_workers * get_num_pts(&slice_settings) * sizeof(Vec3D) + index_bytes;
+    } else {
+        num_bytes += get_num_pts(settings) * sizeof(Vec3D) + (size_t) num_workers * index_bytes;
+    }
+
+    return num_bytes;
+}
+
+size_t get_free_disk(const char *output) {
+    char dir[MAX_LINE];
+    snprintf(dir, MAX_LINE, "%s", output);
+
+    char *slash = strrchr(dir, '/');
+
+    if (slash == NULL) {
+        strcpy(dir, ".");
+    } else if (slash == dir) {
+        dir[1] = '\0';
+    } else {
+        *slash = '\0';
+    }
+
+    struct statvfs fs;
+
+    if (statvfs(dir, &fs) != 0) {
+        return SIZE_MAX;
+    }
+
+    return mul_size((size_t) fs.f_bavail, (size_t) fs.f_frsize);
+}
+
+size_t get_physical_memory(void) {
+    long num_pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGE_SIZE);
+
+    if (num_pages <= 0 || page_size <= 0) {
+        return SIZE_MAX;
+    }
+
+    return mul_size((size_t) num_pages, (size_t) page_size);
+}
+
+int alloc_estimate(Estimate *estimate, const Settings *settings) {
+    make_slice_settings(settings, &estimate->slice_settings);
+
+    estimate->num_tris = get_num_tris(settings);
+    estimate->slice_pts = (Vec3D *) malloc(get_num_pts(&estimate->slice_settings) * sizeof(Vec3D));
+    estimate->slice_indices = (Index *) malloc(3 * estimate->num_tris * sizeof(Index));
+
+    if (estimate->slice_pts == NULL || estimate->slice_indices == NULL || make_profile(settings, &estimate->profile)) {
+        fprintf(stderr, "wingstl: error: unable to allocate memory for output estimate\n");
+        return 1;
+    }
+
+    assign_indices(&estimate->slice_settings, estimate->num_tris, 0, estimate->slice_indices);
+    estimate->counter.sink.kind = BUFFER_SINK;
+
+    return 0;
+}
+
+void free_estimate(Estimate *estimate) {
+    free(estimate->slice_pts);
+    free(estimate->slice_indices);
+    free_profile(&estimate->profile);
+    free_writer(&estimate->counter);
+}
+
+int count_slice_bytes(const Settings *settings, Estimate *estimate, int islice, Format format, size_t *num_bytes) {
+    size_t num_pts = get_num_pts(&estimate->slice_settings);
+
+    if (format == BINARY_STL || format == BINARY_PLY) {
+        *num_bytes = get_fixed_bytes(format, num_pts, estimate->num_tris);
+        return 0;
+    }
+
+    Settings counted = *settings;
+    counted.format = format;
+
+    make_slice_pts(settings, &estimate->profile, islice, estimate->slice_pts);
+
+    if (format == THREE_MF) {
+        int status = open_writer(&estimate->counter, NULL) ||
+                     write_3mf_object(&estimate->counter, estimate->slice_pts, num_pts, estimate->slice_indices,
+                                      estimate->num_tris, islice + 1, settings->decimals) ||
+                     close_writer(&estimate->counter);
+
+        *num_bytes = estimate->counter.sink.target_size;
+        return status;
+    }
+
+    if (write_mesh(&counted, &estimate->counter, estimate->slice_pts, num_pts,
+                   estimate->slice_indices, estimate->num_tris, NULL)) {
+        return 1;
+    }
+
+    *num_bytes = estimate->counter.sink.target_size;
+    return 0;
+}
+
+int show_estimate(const Settings *settings, int num_workers) {
+    Estimate estimate = {.slice_pts = NULL, .slice_indices = NULL, .profile = {0}};
+
+    if (alloc_estimate(&estimate, settings)) {
+        free_estimate(&estimate);
+        return 1;
+    }
+
+    size_t totals[UNKNOWN_FORMAT] = {0};
+    size_t num_bytes = 0;
+    int status = 0;
+
+    printf("Output size estimate (bytes):\n");
+    printf("  %-12s", "Slice");
+
+    for (Format f = ASCII_STL; f < UNKNOWN_FORMAT; f++) {
+        printf("%16s", get_format_name(f));
+    }
+
+    putchar('\n');
+
+    for (int islice = 0; islice < settings->num_slices && !status; islice++) {
+        printf("  %-12d", islice);
+
+        for (Format f = ASCII_STL; f < UNKNOWN_FORMAT && !status; f++) {
+            status = count_slice_bytes(settings, &estimate, islice, f, &num_bytes);
+            totals[f] += num_bytes;
+            printf("%16zu", num_bytes);
+        }
+
+        putchar('\n');
+    }
+
+    totals[THREE_MF] += get_package_overhead(settings, &estimate.counter);
+
+    printf("  %-12s", "total");
+
+    for (Format f = ASCII_STL; f < UNKNOWN_FORMAT; f++) {
+        printf("%16zu", totals[f]);
+    }
+
+    putchar('\n');
+
+    bool is_indexed_run = settings->stream || is_indexed(settings->format);
+    size_t num_pts = is_indexed_run ? mul_size(get_num_pts(&estimate.slice_settings), settings->num_slices)
+                                    : get_num_pts(settings);
+    size_t free_disk = (to_sink_kind(settings->output) == FILE_SINK) ? get_free_disk(settings->output) : SIZE_MAX;
+
+    printf("\nRun estimate:\n");
+    printf("  Vertices generated:\t%zu\n", num_pts);
+    printf("  Triangles per slice:\t%zu\n", estimate.num_tris);
+    printf("  Triangles in total:\t%zu\n", mul_size(estimate.num_tris, settings->num_slices));
+    printf("  Output format:\t%s (%zu bytes)\n", get_format_name(settings->format), totals[settings->format]);
+    printf("  Peak memory:\t\t%.2f MiB\n", (double) get_memory_estimate(settings, num_workers) / BYTES_PER_MIB);
+
+    if (free_disk != SIZE_MAX) {
+        printf("  Free disk space:\t%.2f MiB\n", (double) free_disk / BYTES_PER_MIB);
+    }
+
+    free_estimate(&estimate);
+
+    return status;
+}
+
+int check_budget(const Settings *settings, int num_workers) {
+    size_t memory = get_memory_estimate(settings, num_workers);
+
+    if (settings->memory_budget > 0 && (double) memory > settings->memory_budget * BYTES_PER_MIB) {
+        fprintf(stderr, "wingstl: error: estimated peak memory of %.2f MiB exceeds the budget of %d MiB (flag '%s'); ",
+                (double) memory / BYTES_PER_MIB, settings->memory_budget, FLAG_MEMORY_BUDGET);
+        fprintf(stderr, "try reducing '%s' or '%s', or streaming with '%s'\n", FLAG_NUM_THREADS, FLAG_CHORD_PTS, FLAG_STREAM);
+        return 1;
+    }
+
+    if (!settings->check_disk || to_sink_kind(settings->output) != FILE_SINK) {
+        return 0;
+    }
+
+    Estimate estimate = {.slice_pts = NULL, .slice_indices = NULL, .profile = {0}};
+    size_t total = 0, num_bytes = 0;
+    int status = alloc_estimate(&estimate, settings);
+
+    for (int islice = 0; islice < settings->num_slices && !status; islice++) {
+        status = count_slice_bytes(settings, &estimate, islice, settings->format, &num_bytes);
+        total += num_bytes;
+    }
+
+    if (!status && settings->format == THREE_MF) {
+        total += get_package_overhead(settings, &estimate.counter);
+    }
+
+    free_estimate(&estimate);
+
+    size_t free_disk = get_free_disk(settings->output);
+
+    if (!status && free_disk != SIZE_MAX && total > free_disk) {
+        fprintf(stderr, "wingstl: error: output needs %.2f MiB but only %.2f MiB of disk space is free\n",
+                (double) total / BYTES_PER_MIB, (double) free_disk / BYTES_PER_MIB);
+        status = 1;
+    }
+
+    return status;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
@@ -3,56 +3,423 @@
  * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
  */
 
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <ctype.h>
 #include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 #include <stdbool.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
+#include "sink.h"
 #include "utils.h"
 #include "types.h"
+#include "stats.h"
 #include "engine.h"
+#include "threemf.h"
 #include "validation.h"
 
-int write_stl(Vec3D *pts, const size_t *indices, size_t num_tris, const char *fname) {
-    FILE *fp = fopen(fname, "w");
+size_t get_name_length(const Settings *settings) {
+    size_t len_output = (settings->output == NULL) ? strlen(DEFAULT_OUTPUT) : strlen(settings->output);
+
+    return len_output + num_digits_in(settings->num_slices - 1) + 3;
+}
+
+void make_slice_name(const Settings *settings, int islice, char *name) {
+    const char *output = (settings->output == NULL) ? DEFAULT_OUTPUT : settings->output;
+
+    strcpy(name, output);
+
+    if (settings->num_slices > 1) {
+        sprintf(name + strlen(output) - 4, "(%d)%s", islice, get_format_ext(settings->format));
+    }
+}
+
+int open_writer(Writer *writer, const char *fname) {
+    writer->size = 0;
 
-    if (fp == NULL) {
-        fprintf(stderr, "wingstl: error: unable to open .stl file for writing\n");
+    if (writer->data == NULL) {
+        void *data = NULL;
+
+        writer->capacity = WRITE_BUFFER_SIZE;
+        writer->data = (posix_memalign(&data, WRITE_BUFFER_ALIGN, writer->capacity) == 0) ? (char *) data : NULL;
+    }
+
+    if (writer->data == NULL) {
+        fprintf(stderr, "wingstl: error: unable to allocate memory for output buffer\n");
+        return 1;
+    }
+
+    Timer timer;
+    start_timer(&timer, false);
+
+    int status = open_sink(&writer->sink, fname);
+    stop_timer(&timer, writer->stats, STAGE_WRITE);
+
+    return status;
+}
+
+int send_writer(Writer *writer, struct iovec *iov, int iovcnt) {
+    size_t num_bytes = writer->sink.target_size;
+
+    for (int i = 0; i < iovcnt && writer->crc_table != NULL; i++) {
+        writer->crc = update_crc(writer->crc_table, writer->crc, iov[i].iov_base, iov[i].iov_len);
+    }
+
+    Timer timer;
+    start_timer(&timer, false);
+
+    int status = write_sink(&writer->sink, iov, iovcnt);
+    stop_timer(&timer, writer->stats, STAGE_WRITE);
+
+    if (writer->stats != NULL) {
+        writer->stats->num_bytes += writer->sink.target_size - num_bytes;
+    }
+
+    writer->size = 0;
+    return status;
+}
+
+int flush_writer(Writer *writer) {
+    if (writer->size == 0) {
+        return 0;
+    }
+
+    struct iovec iov = {.iov_base = writer->data, .iov_len = writer->size};
+
+    return send_writer(writer, &iov, 1);
+}
+
+int write_direct(Writer *writer, const void *data, size_t num_bytes) {
+    struct iovec iov[2] = {
+        {.iov_base = writer->data, .iov_len = writer->size},
+        {.iov_base = (void *) data, .iov_len = num_bytes}
+    };
+
+    return send_writer(writer, iov, 2);
+}
+
+int close_writer(Writer *writer) {
+    int status = flush_writer(writer);
+
+    Timer timer;
+    start_timer(&timer, false);
+
+    if (close_sink(&writer->sink) && !status) {
+        status = 1;
+    }
+
+    stop_timer(&timer, writer->stats, STAGE_WRITE);
+
+    return status;
+}
+
+void free_writer(Writer *writer) {
+    free(writer->data);
+
+    writer->data = NULL;
+    writer->capacity = 0;
+}
+
+char *reserve_bytes(Writer *writer, size_t num_bytes) {
+    if (writer->size + num_bytes > writer->capacity && flush_writer(writer)) {
+        return NULL;
+    }
+
+    return writer->data + writer->size;
+}
+
+void commit_bytes(Writer *writer, size_t num_bytes) {
+    writer->size += num_bytes;
+}
+
+int write_text(Writer *writer, const char *text) {
+    size_t length = strlen(text);
+    char *ptr = reserve_bytes(writer, length);
+
+    if (ptr == NULL) {
+        return 1;
+    }
+
+    memcpy(ptr, text, length);
+    commit_bytes(writer, length);
+
+    return 0;
+}
+
+char *append_text(char *dst, const char *text) {
+    while (*text != '\0') {
+        *dst++ = *text++;
+    }
+
+    return dst;
+}
+
+char *append_vec(char *dst, const Vec3D *v, int decimals) {
+    *dst++ = ' ';
+    dst += format_float(dst, v->x, decimals);
+    *dst++ = ' ';
+    dst += format_float(dst, v->y, decimals);
+    *dst++ = ' ';
+    dst += format_float(dst, v->z, decimals);
+    *dst++ = '\n';
+
+    return dst;
+}
+
+int write_ascii_stl(Writer *writer, Vec3D *pts, const Index *indices, size_t num_tris, const char *fname, int decimals) {
+    if (open_writer(writer, fname)) {
         return 1;
     }
 
     size_t k = 0;
 
     Vec3D a, b, n;
-    Vec3D *v0 = NULL;
-    Vec3D *v1 = NULL;
-    Vec3D *v2 = NULL;
+    Vec3D *v[3];
+
+    char *start = NULL;
+    char *ptr = NULL;
+
+    if (write_text(writer, "solid \n")) {
+        close_writer(writer);
+        return 1;
+    }
+
+    for (size_t i = 0; i < num_tris; i++) {
+        v[0] = pts + indices[k++];
+        v[1] = pts + indices[k++];
+        v[2] = pts + indices[k++];
+
+        subtract(v[1], v[0], &a);
+        subtract(v[2], v[0], &b);
+        cross(&a, &b, &n);
+        normalize(&n);
+
+        start = reserve_bytes(writer, MAX_FACET_CHARS);
+
+        if (start == NULL) {
+            close_writer(writer);
+            return 1;
+        }
+
+        ptr = append_text(start, "  facet normal");
+        ptr = append_vec(ptr, &n, decimals);
+        ptr = append_text(ptr, "    outer loop\n");
 
-    fprintf(fp, "solid \n");
+        for (int j = 0; j < 3; j++) {
+            ptr = append_text(ptr, "      vertex");
+            ptr = append_vec(ptr, v[j], decimals);
+        }
+
+        ptr = append_text(ptr, "    endloop\n  endfacet\n");
+        commit_bytes(writer, (size_t) (ptr - start));
+    }
+
+    if (write_text(writer, "endsolid ")) {
+        close_writer(writer);
+        return 1;
+    }
+
+    return close_writer(writer);
+}
+
+int write_binary_stl(Writer *writer, Vec3D *pts, const Index *indices, size_t num_tris, const char *fname) {
+    if (num_tris > UINT32_MAX) {
+        fprintf(stderr, "wingstl: error: too many triangles for binary .stl file\n");
+        return 1;
+    }
+
+    if (open_writer(writer, fname)) {
+        return 1;
+    }
+
+    unsigned char *record = (unsigned char *) reserve_bytes(writer, STL_HEADER_SIZE + 4);
+
+    memset(record, 0, STL_HEADER_SIZE);
+    strcpy((char *) record, "binary STL generated by wingstl");
+    put_uint32(record + STL_HEADER_SIZE, (uint32_t) num_tris);
+    commit_bytes(writer, STL_HEADER_SIZE + 4);
+
+    size_t k = 0;
+
+    Vec3D a, b, n;
+    Vec3D *v[3];
 
     for (size_t i = 0; i < num_tris; i++) {
-        v0 = pts + indices[k++];
-        v1 = pts + indices[k++];
-        v2 = pts + indices[k++];
+        v[0] = pts + indices[k++];
+        v[1] = pts + indices[k++];
+        v[2] = pts + indices[k++];
 
-        subtract(v1, v0, &a);
-        subtract(v2, v0, &b);
+        subtract(v[1], v[0], &a);
+        subtract(v[2], v[0], &b);
         cross(&a, &b, &n);
         normalize(&n);
 
-        fprintf(fp, "  facet normal %f %f %f\n", n.x, n.y, n.z);
-        fprintf(fp, "    outer loop\n");
-        fprintf(fp, "      vertex %f %f %f\n", v0->x, v0->y, v0->z);
-        fprintf(fp, "      vertex %f %f %f\n", v1->x, v1->y, v1->z);
-        fprintf(fp, "      vertex %f %f %f\n", v2->x, v2->y, v2->z);
-        fprintf(fp, "    endloop\n");
-        fprintf(fp, "  endfacet\n");
+        record = (unsigned char *) reserve_bytes(writer, STL_FACET_SIZE);
+
+        if (record == NULL) {
+            close_writer(writer);
+            return 1;
+        }
+
+        commit_bytes(writer, STL_FACET_SIZE);
+
+        put_float(record, n.x);
+        put_float(record + 4, n.y);
+        put_float(record + 8, n.z);
+
+        for (int j = 0; j < 3; j++) {
+            put_float(record + 12 + 12 * j, v[j]->x);
+            put_float(record + 16 + 12 * j, v[j]->y);
+            put_float(record + 20 + 12 * j, v[j]->z);
+        }
+
+        put_uint16(record + 48, 0);
     }
 
-    fprintf(fp, "endsolid ");
-    fclose(fp);
+    return close_writer(writer);
+}
 
-    return 0;
+int format_ply_header(char *header, size_t num_pts, size_t num_tris) {
+    return sprintf(header, "ply\nformat binary_little_endian 1.0\ncomment generated by wingstl\n"
+                           "element vertex %zu\nproperty float x\nproperty float y\nproperty float z\n"
+                           "element face %zu\nproperty list uchar uint vertex_indices\nend_header\n", num_pts, num_tris);
+}
+
+int write_binary_ply(Writer *writer, const Vec3D *pts, size_t num_pts, const Index *indices, size_t num_tris, const char *fname) {
+    if (num_pts > UINT32_MAX) {
+        fprintf(stderr, "wingstl: error: too many vertices for .ply file\n");
+        return 1;
+    }
+
+    if (open_writer(writer, fname)) {
+        return 1;
+    }
+
+    char header[MAX_HEADER_CHARS];
+    format_ply_header(header, num_pts, num_tris);
+
+    if (write_text(writer, header)) {
+        close_writer(writer);
+        return 1;
+    }
+
+    unsigned char *record = NULL;
+
+    if (sizeof(Vec3D) == PLY_VERTEX_SIZE && is_little_endian()) {
+        if (write_direct(writer, pts, num_pts * PLY_VERTEX_SIZE)) {
+            close_writer(writer);
+            return 1;
+        }
+
+        num_pts = 0;
+    }
+
+    for (size_t i = 0; i < num_pts; i++) {
+        record = (unsigned char *) reserve_bytes(writer, PLY_VERTEX_SIZE);
+
+        if (record == NULL) {
+            close_writer(writer);
+            return 1;
+        }
+
+        commit_bytes(writer, PLY_VERTEX_SIZE);
+
+        put_float(record, pts[i].x);
+        put_float(record + 4, pts[i].y);
+        put_float(record + 8, pts[i].z);
+    }
+
+    size_t k = 0;
+
+    for (size_t i = 0; i < num_tris; i++) {
+        record = (unsigned char *) reserve_bytes(writer, PLY_FACE_SIZE);
+
+        if (record == NULL) {
+            close_writer(writer);
+            return 1;
+        }
+
+        commit_bytes(writer, PLY_FACE_SIZE);
+
+        record[0] = 3;
+        put_uint32(record + 1, (uint32_t) indices[k++]);
+        put_uint32(record + 5, (uint32_t) indices[k++]);
+        put_uint32(record + 9, (uint32_t) indices[k++]);
+    }
+
+    return close_writer(writer);
+}
+
+int write_ascii_obj(Writer *writer, const Vec3D *pts, size_t num_pts, const Index *indices, size_t num_tris, const char *fname, int decimals) {
+    if (open_writer(writer, fname)) {
+        return 1;
+    }
+
+    if (write_text(writer, "# generated by wingstl\n")) {
+        close_writer(writer);
+        return 1;
+    }
+
+    char *start = NULL;
+    char *ptr = NULL;
+
+    for (size_t i = 0; i < num_pts; i++) {
+        start = reserve_bytes(writer, MAX_FACET_CHARS);
+
+        if (start == NULL) {
+            close_writer(writer);
+            return 1;
+        }
+
+        ptr = append_text(start, "v");
+        ptr = append_vec(ptr, pts + i, decimals);
+        commit_bytes(writer, (size_t) (ptr - start));
+    }
+
+    size_t k = 0;
+
+    for (size_t i = 0; i < num_tris; i++) {
+        start = reserve_bytes(writer, MAX_FACET_CHARS);
+
+        if (start == NULL) {
+            close_writer(writer);
+            return 1;
+        }
+
+        ptr = append_text(start, "f");
+
+        for (int j = 0; j < 3; j++) {
+            *ptr++ = ' ';
+            ptr += format_index(ptr, (size_t) indices[k++] + 1);
+        }
+
+        *ptr++ = '\n';
+        commit_bytes(writer, (size_t) (ptr - start));
+    }
+
+    return close_writer(writer);
+}
+
+int write_mesh(const Settings *settings, Writer *writer, Vec3D *pts, size_t num_pts, const Index *indices, size_t num_tris, const char *fname) {
+    switch (settings->format) {
+        case BINARY_STL:
+            return write_binary_stl(writer, pts, indices, num_tris, fname);
+        case BINARY_PLY:
+            return write_binary_ply(writer, pts, num_pts, indices, num_tris, fname);
+        case ASCII_OBJ:
+            return write_ascii_obj(writer, pts, num_pts, indices, num_tris, fname, settings->decimals);
+        case THREE_MF:
+            return write_3mf(settings, writer, pts, num_pts, indices, num_tris, fname);
+        default:
+            return write_ascii_stl(writer, pts, indices, num_tris, fname, settings->decimals);
+    }
 }
 
 LineResult parse_line(const char *line, bool first_line, float *x, float *y) {
@@ -76,36 +443,240 @@ LineResult parse_line(const char *line, bool first_line, float *x, float *y) {
     return VALUE_LINE;
 }
 
-int read_dat(const char *fname, Airfoil *airfoil) {
-    FILE *f = fopen(fname, "r");
+const char *skip_space(const char *ptr, const char *end) {
+    while (ptr < end && isspace((unsigned char) *ptr)) {
+        ptr++;
+    }
+
+    return ptr;
+}
+
+const char *parse_decimal(const char *ptr, const char *end, float *value) {
+    static const double powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
 
-    if (f == NULL) {
-        fprintf(stderr, "wingstl: error: unable to open .dat file for reading\n");
+    bool is_negative = false;
+    bool has_digits = false;
+
+    uint64_t mantissa = 0;
+    int num_digits = 0;
+    int exponent = 0;
+
+    if (ptr < end && (*ptr == '+' || *ptr == '-')) {
+        is_negative = (*ptr++ == '-');
+    }
+
+    for (bool in_fraction = false; ptr < end; ptr++) {
+        if (*ptr == '.' && !in_fraction) {
+            in_fraction = true;
+            continue;
+        }
+
+        if (!isdigit((unsigned char) *ptr)) {
+            break;
+        }
+
+        has_digits = true;
+
+        if (mantissa == 0 && *ptr == '0') {
+            exponent -= in_fraction;
+            continue;
+        }
+
+        if (num_digits == MAX_DECIMAL_DIGITS) {
+            return NULL;
+        }
+
+        mantissa = 10 * mantissa + (uint64_t) (*ptr - '0');
+        exponent -= in_fraction;
+        num_digits++;
+    }
+
+    if (!has_digits) {
+        return NULL;
+    }
+
+    if (ptr < end && (*ptr == 'e' || *ptr == 'E')) {
+        bool is_exp_negative = false;
+        int exp_value = 0;
+
+        if (++ptr < end && (*ptr == '+' || *ptr == '-')) {
+            is_exp_negative = (*ptr++ == '-');
+        }
+
+        if (ptr == end || !isdigit((unsigned char) *ptr)) {
+            return NULL;
+        }
+
+        for (; ptr < end && isdigit((unsigned char) *ptr); ptr++) {
+            if (exp_value > MAX_DECIMAL_EXP) {
+                return NULL;
+            }
+
+            exp_value = 10 * exp_value + (*ptr - '0');
+        }
+
+        exponent += is_exp_negative ? -exp_value : exp_value;
+    }
+
+    if (mantissa == 0) {
+        *value = is_negative ? -0.0f : 0.0f;
+        return ptr;
+    }
+
+    if (mantissa > ((uint64_t) 1 << 53) || exponent < -22 || exponent > 22) {
+        return NULL;
+    }
+
+    double exact = (exponent < 0) ? (double) mantissa / powers[-exponent] : (double) mantissa * powers[exponent];
+    float rounded = (float) exact;
+
+    if ((double) rounded != exact) {
+        float neighbor = nextafterf(rounded, (exact > rounded) ? INFINITY : -INFINITY);
+
+        if (((double) rounded + (double) neighbor) * 0.5 == exact) {
+            return NULL;
+        }
+    }
+
+    *value = is_negative ? -rounded : rounded;
+    return ptr;
+}
+
+LineResult scan_line(const char *start, const char *end, bool first_line, float *x, float *y) {
+    if (first_line) {
+        return (start == end) ? EMPTY_HEADER_LINE : VALID_HEADER_LINE;
+    }
+
+    if (start == end) {
+        return EMPTY_BODY_LINE;
+    }
+
+    const char *ptr = parse_decimal(skip_space(start, end), end, x);
+
+    if (ptr != NULL && ptr < end && isspace((unsigned char) *ptr)) {
+        ptr = parse_decimal(skip_space(ptr, end), end, y);
+
+        if (ptr != NULL && (ptr == end || !isalpha((unsigned char) *ptr))) {
+            return (*x > 1.0f && *y > 1.0f) ? POINT_QUANTITY_LINE : VALUE_LINE;
+        }
+    }
+
+    size_t length = (size_t) (end - start);
+    char *line = (char *) malloc((length + 1) * sizeof(char));
+
+    if (line == NULL) {
+        return INVALID_FORMAT_LINE;
+    }
+
+    memcpy(line, start, length);
+    line[length] = '\0';
+
+    LineResult result = parse_line(line, false, x, y);
+    free(line);
+
+    return result;
+}
+
+int map_file(const char *fname, const char **data, size_t *size) {
+    int fd = open(fname, O_RDONLY);
+
+    if (fd < 0) {
+        return 1;
+    }
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return 1;
+    }
+
+    *size = (size_t) st.st_size;
+    *data = NULL;
+
+    if (*size > 0) {
+        void *ptr = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (ptr == MAP_FAILED) {
+            close(fd);
+            return 1;
+        }
+
+        *data = (const char *) ptr;
+    }
+
+    close(fd);
+    return 0;
+}
+
+void unmap_file(const char *data, size_t size) {
+    if (data != NULL) {
+        munmap((void *) data, size);
+    }
+}
+
+int grow_airfoil(Airfoil *airfoil) {
+    if (airfoil->capacity > INT_MAX / 2) {
         return 1;
     }
 
+    int capacity = (airfoil->capacity > 0) ? 2 * airfoil->capacity : INITIAL_AIRFOIL_PTS;
+    Vec2D *pts = (Vec2D *) realloc(airfoil->pts, capacity * sizeof(Vec2D));
+
+    if (pts == NULL) {
+        return 1;
+    }
+
+    airfoil->pts = pts;
+    airfoil->capacity = capacity;
+
+    return 0;
+}
+
+int parse_dat(const char *data, size_t size, Airfoil *airfoil, bool quiet) {
     int line_no = 1;
     int num_invalid = 0;
     int num_breaks = 0;
     int num_quantity = 0;
 
-    float xmin, xmax, x, y;
-    char line[MAX_LINE];
+    float xmin = 0.0f, xmax = 0.0f, x, y;
+    size_t header_length;
 
-    LineResult result, last_result;
+    const char *ptr = data;
+    const char *end = data + size;
+    const char *line_end = NULL;
+    const char *next = NULL;
+
+    LineResult result;
+    LineResult last_result = VALID_HEADER_LINE;
 
     bool has_break_b4_p0 = false;
     bool has_empty_header = false;
 
     airfoil->num_pts = 0;
+    airfoil->lednicer_index = 0;
+
+    while (ptr < end) {
+        line_end = (const char *) memchr(ptr, '\n', (size_t) (end - ptr));
+        next = (line_end == NULL) ? end : line_end + 1;
+        line_end = (line_end == NULL) ? end : line_end;
 
-    while (fgets(line, sizeof(line), f) != NULL) {
-        rstrip(line);
-        result = parse_line(line, (line_no == 1), &x, &y);
+        while (line_end > ptr && isspace((unsigned char) line_end[-1])) {
+            line_end--;
+        }
+
+        result = scan_line(ptr, line_end, (line_no == 1), &x, &y);
 
         switch (result) {
             case VALID_HEADER_LINE:
-                strcpy(airfoil->header, line);
+                header_length = (size_t) (line_end - ptr);
+                header_length = (header_length < MAX_LINE - 1) ? header_length : MAX_LINE - 1;
+
+                memcpy(airfoil->header, ptr, header_length);
+                airfoil->header[header_length] = '\0';
                 break;
             case EMPTY_HEADER_LINE:
                 has_empty_header = true;
@@ -116,9 +687,9 @@ int read_dat(const char *fname, Airfoil *airfoil) {
             case EMPTY_BODY_LINE:
                 break;
             case VALUE_LINE:
-                if (airfoil->num_pts == MAX_AIRFOIL_PTS) {
-                    fprintf(stderr, "wingstl: error: .dat file contains too many points\n");
-                    fclose(f); return 1;
+                if (airfoil->num_pts == airfoil->capacity && grow_airfoil(airfoil)) {
+                    if (!quiet) fprintf(stderr, "wingstl: error: unable to allocate memory for .dat file points\n");
+                    free_airfoil(airfoil); return 1;
                 }
 
                 airfoil->pts[airfoil->num_pts].x = x;
@@ -143,20 +714,44 @@ int read_dat(const char *fname, Airfoil *airfoil) {
                 num_quantity += 1;
                 break;
             default:
-                fprintf(stderr, "wingstl: error: unable to parse line %d of .dat file\n", line_no);
-                fclose(f); return 1;
+                if (!quiet) fprintf(stderr, "wingstl: error: unable to parse line %d of .dat file\n", line_no);
+                free_airfoil(airfoil); return 1;
         }
 
+        ptr = next;
         line_no++;
         last_result = result;
     }
 
-    if (validate_file(num_breaks, num_quantity, num_invalid, has_break_b4_p0, has_empty_header)) {
-        fclose(f); return 1;
+    if (validate_file(num_breaks, num_quantity, num_invalid, has_break_b4_p0, has_empty_header, quiet)) {
+        free_airfoil(airfoil); return 1;
+    }
+
+    if (airfoil->num_pts > 0) {
+        adjust_and_scale(airfoil, xmin, xmax);
+    }
+
+    if (make_surfaces(airfoil) || make_spline(airfoil)) {
+        if (!quiet) fprintf(stderr, "wingstl: error: unable to allocate memory for airfoil surfaces\n");
+        free_airfoil(airfoil); return 1;
     }
 
-    adjust_and_scale(airfoil, xmin, xmax);
-    fclose(f); return 0;
+    return 0;
+}
+
+int read_dat(const char *fname, Airfoil *airfoil, bool quiet) {
+    const char *data = NULL;
+    size_t size = 0;
+
+    if (map_file(fname, &data, &size)) {
+        if (!quiet) fprintf(stderr, "wingstl: error: unable to open .dat file for reading\n");
+        return 1;
+    }
+
+    int status = parse_dat(data, size, airfoil, quiet);
+    unmap_file(data, size);
+
+    return status;
 }
 
 /*
@@ -0,0 +1,395 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <stdio.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <sys/stat.h>
+
+#include "cache.h"
+#include "utils.h"
+#include "types.h"
+#include "fileio.h"
+#include "engine.h"
+#include "library.h"
+#include "parallel.h"
+#include "constants.h"
+#include "validation.h"
+
+char *make_entry_name(const char *path, size_t length) {
+    const char *start = path;
+
+    for (size_t i = 0; i < length; i++) {
+        if (path[i] == '/' || path[i] == '\\') {
+            start = path + i + 1;
+        }
+    }
+
+    length -= (size_t) (start - path);
+
+    if (length > 4 && (strncmp(start + length - 4, ".dat", 4) == 0 || strncmp(start + length - 4, ".DAT", 4) == 0)) {
+        length -= 4;
+    }
+
+    char *name = (char *) malloc((length + 1) * sizeof(char));
+
+    if (name != NULL) {
+        memcpy(name, start, length);
+        name[length] = '\0';
+    }
+
+    return name;
+}
+
+int add_entry(Library *library, const char *member, size_t length, char *path, const char *data, size_t size) {
+    if (library->num_entries == library->capacity) {
+        int capacity = (library->capacity > 0) ? 2 * library->capacity : 64;
+        LibraryEntry *entries = (LibraryEntry *) realloc(library->entries, capacity * sizeof(LibraryEntry));
+
+        if (entries == NULL) {
+            free(path);
+            return 1;
+        }
+
+        library->entries = entries;
+        library->capacity = capacity;
+    }
+
+    LibraryEntry *entry = library->entries + library->num_entries;
+
+    entry->index = library->num_entries;
+    entry->status = 0;
+    entry->path = path;
+    entry->data = data;
+    entry->size = size;
+    entry->name = make_entry_name(member, length);
+    entry->airfoil = (Airfoil) {.num_pts = DEFAULT_AIRFOIL};
+
+    if (entry->name == NULL) {
+        free(path);
+        return 1;
+    }
+
+    library->num_entries++;
+
+    return 0;
+}
+
+int scan_directory(const char *dir_name, Library *library) {
+    DIR *dir = opendir(dir_name);
+
+    if (dir == NULL) {
+        fprintf(stderr, "wingstl: error: unable to open airfoil library directory\n");
+        return 1;
+    }
+
+    struct dirent *item;
+    struct stat st;
+
+    while ((item = readdir(dir)) != NULL) {
+        if (!has_ext(item->d_name, ".dat") && !has_ext(item->d_name, ".DAT")) {
+            continue;
+        }
+
+        char *path = (char *) malloc((strlen(dir_name) + strlen(item->d_name) + 2) * sizeof(char));
+
+        if (path == NULL) {
+            fprintf(stderr, "wingstl: error: unable to allocate memory for airfoil library\n");
+            closedir(dir); return 1;
+        }
+
+        sprintf(path, "%s/%s", dir_name, item->d_name);
+
+        if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) {
+            free(path);
+            continue;
+        }
+
+        if (add_entry(library, item->d_name, strlen(item->d_name), path, NULL, 0)) {
+            fprintf(stderr, "wingstl: error: unable to allocate memory for airfoil library\n");
+            closedir(dir); return 1;
+        }
+    }
+
+    closedir(dir);
+
+    return 0;
+}
+
+bool is_tar_header_valid(const unsigned char *block) {
+    unsigned long checksum = 0;
+    unsigned long expected = 0;
+
+    for (int i = 0; i < TAR_BLOCK_SIZE; i++) {
+        checksum += (i >= 148 && i < 156) ? ' ' : block[i];
+    }
+
+    for (int i = 148; i < 156 && block[i] != '\0' && block[i] != ' '; i++) {
+        if (block[i] < '0' || block[i] > '7') {
+            return false;
+        }
+
+        expected = 8 * expected + (block[i] - '0');
+    }
+
+    return checksum == expected;
+}
+
+int scan_archive(const char *fname, Library *library) {
+    if (map_file(fname, &library->archive, &library->archive_size)) {
+        fprintf(stderr, "wingstl: error: unable to open airfoil library archive\n");
+        return 1;
+    }
+
+    const unsigned char *data = (const unsigned char *) library->archive;
+    size_t offset = 0;
+
+    while (offset + TAR_BLOCK_SIZE <= library->archive_size) {
+        const unsigned char *block = data + offset;
+        bool is_zero = true;
+
+        for (int i = 0; i < TAR_BLOCK_SIZE && is_zero; i++) {
+            is_zero = (block[i] == 0);
+        }
+
+        if (is_zero) {
+            return 0;
+        }
+
+        if (!is_tar_header_valid(block)) {
+            fprintf(stderr, "wingstl: error: airfoil library archive is not a valid tar file\n");
+            return 1;
+        }
+
+        size_t size = 0;
+
+        for (int i = 124; i < 136 && block[i] >= '0' && block[i] <= '7'; i++) {
+            size = 8 * size + (size_t) (block[i] - '0');
+        }
+
+        offset += TAR_BLOCK_SIZE;
+
+        if (size > library->archive_size - offset) {
+            fprintf(stderr, "wingstl: error: airfoil library archive is truncated\n");
+            return 1;
+        }
+
+        char member[TAR_BLOCK_SIZE];
+        size_t length = 0;
+
+        if (memcmp(block + 257, "ustar", 5) == 0 && block[345] != '\0') {
+            length = strnlen((const char *) block + 345, 155);
+            memcpy(member, block + 345, length);
+            member[length++] = '/';
+        }
+
+        size_t name_length = strnlen((const char *) block, 100);
+        memcpy(member + length, block, name_length);
+
+        length += name_length;
+        member[length] = '\0';
+
+        bool is_regular = (block[156] == '0' || block[156] == '\0');
+
+        if (is_regular && (has_ext(member, ".dat") || has_ext(member, ".DAT")) &&
+            add_entry(library, member, length, NULL, library->archive + offset, size)) {
+            fprintf(stderr, "wingstl: error: unable to allocate memory for airfoil library\n");
+            return 1;
+        }
+
+        offset += (size + TAR_BLOCK_SIZE - 1) / TAR_BLOCK_SIZE * TAR_BLOCK_SIZE;
+    }
+
+    return 0;
+}
+
+int compare_entries(const void *a, const void *b) {
+    const LibraryEntry *ea = (const LibraryEntry *) a;
+    const LibraryEntry *eb = (const LibraryEntry *) b;
+    int order = strcmp(ea->name, eb->name);
+
+    return (order != 0) ? order : (ea->index > eb->index) - (ea->index < eb->index);
+}
+
+int load_entry(void *context, int ientry, int iworker) {
+    LibraryLoad *load = (LibraryLoad *) context;
+    LibraryEntry *entry = load->library->entries + ientry;
+
+    (void) iworker;
+
+    free_airfoil(&entry->airfoil);
+    entry->airfoil = (Airfoil) {.num_pts = DEFAULT_AIRFOIL};
+
+    if (entry->path != NULL) {
+        entry->status = load_dat(entry->path, &entry->airfoil, load->cache_dir, load->quiet);
+    } else {
+        entry->status = parse_dat(entry->data, entry->size, &entry->airfoil, load->quiet);
+    }
+
+    entry->status = entry->status || validate_airfoil(&entry->airfoil, load->quiet);
+
+    if (entry->status) {
+        free_airfoil(&entry->airfoil);
+    }
+
+    return 0;
+}
+
+int load_library(const char *path, Library *library, const char *cache_dir, int num_threads) {
+    struct stat st;
+
+    if (stat(path, &st) != 0) {
+        fprintf(stderr, "wingstl: error: airfoil library '%s' does not exist\n", path);
+        return 1;
+    }
+
+    library->path = (char *) malloc((strlen(path) + 1) * sizeof(char));
+
+    if (library->path == NULL) {
+        fprintf(stderr, "wingstl: error: unable to allocate memory for airfoil library\n");
+        return 1;
+    }
+
+    strcpy(library->path, path);
+
+    if (S_ISDIR(st.st_mode) ? scan_directory(path, library) : scan_archive(path, library)) {
+        return 1;
+    }
+
+    if (library->num_entries == 0) {
+        fprintf(stderr, "wingstl: error: airfoil library '%s' contains no .dat files\n", path);
+        return 1;
+    }
+
+    qsort(library->entries, library->num_entries, sizeof(LibraryEntry), compare_entries);
+
+    int num_unique = 1;
+
+    for (int i = 1; i < library->num_entries; i++) {
+        if (strcmp(library->entries[i].name, library->entries[num_unique - 1].name) == 0) {
+            free(library->entries[i].name);
+            free(library->entries[i].path);
+        } else {
+            library->entries[num_unique++] = library->entries[i];
+        }
+    }
+
+    if (num_unique < library->num_entries) {
+        fprintf(stderr, "wingstl: warning: %d duplicate airfoil names in library; keeping the first of each\n",
+                library->num_entries - num_unique);
+    }
+
+    library->num_entries = num_unique;
+
+    LibraryLoad load = {.library = library, .cache_dir = cache_dir, .quiet = true};
+
+    run_parallel(num_threads, library->num_entries, load_entry, NULL, &load);
+
+    int num_invalid = 0;
+
+    for (int i = 0; i < library->num_entries; i++) {
+        num_invalid += (library->entries[i].status != 0);
+    }
+
+    if (num_invalid > 0) {
+        fprintf(stderr, "wingstl: warning: %d of %d airfoils in library '%s' are invalid\n",
+                num_invalid, library->num_entries, path);
+    }
+
+    return 0;
+}
+
+const LibraryEntry *find_entry(const Library *library, const char *name) {
+    char *key = make_entry_name(name, strlen(name));
+
+    if (key == NULL) {
+        return NULL;
+    }
+
+    int lo = 0;
+    int hi = library->num_entries - 1;
+    const LibraryEntry *entry = NULL;
+
+    while (lo <= hi && entry == NULL) {
+        int mid = lo + (hi - lo) / 2;
+        int order = strcmp(key, library->entries[mid].name);
+
+        if (order == 0) {
+            entry = library->entries + mid;
+        } else if (order < 0) {
+            hi = mid - 1;
+        } else {
+            lo = mid + 1;
+        }
+    }
+
+    free(key);
+    return entry;
+}
+
+int select_entry(const Library *library, const LibraryEntry *entry, Airfoil *airfoil, const char *cache_dir) {
+    if (entry->status) {
+        LibraryEntry retry = *entry;
+        Library single = {.num_entries = 1, .entries = &retry};
+        LibraryLoad load = {.library = &single, .cache_dir = cache_dir, .quiet = false};
+
+        retry.airfoil = (Airfoil) {.num_pts = DEFAULT_AIRFOIL};
+        load_entry(&load, 0, 0);
+        free_airfoil(&retry.airfoil);
+
+        fprintf(stderr, "wingstl: error: airfoil '%s' in library '%s' is invalid\n", entry->name, library->path);
+        return 1;
+    }
+
+    if (copy_airfoil(airfoil, &entry->airfoil)) {
+        fprintf(stderr, "wingstl: error: unable to allocate memory for airfoil\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+void free_library(Library *library) {
+    for (int i = 0; i < library->num_entries; i++) {
+        free_airfoil(&library->entries[i].airfoil);
+        free(library->entries[i].name);
+        free(library->entries[i].path);
+    }
+
+    unmap_file(library->archive, library->archive_size);
+    free(library->entries);
+    free(library->path);
+
+    library->path = NULL;
+    library->archive = NULL;
+    library->archive_size = 0;
+    library->entries = NULL;
+    library->num_entries = 0;
+    library->capacity = 0;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
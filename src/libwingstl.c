@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "utils.h"
+#include "types.h"
+#include "fileio.h"
+#include "engine.h"
+#include "parsing.h"
+#include "spacing.h"
+#include "constants.h"
+#include "libwingstl.h"
+#include "validation.h"
+
+static void *default_alloc(size_t size, void *user) {
+    (void) user;
+
+    return malloc(size);
+}
+
+static void default_free(void *ptr, void *user) {
+    (void) user;
+
+    free(ptr);
+}
+
+static void *ctx_alloc(WingContext *ctx, size_t count, size_t size) {
+    size_t num_bytes = mul_size(count, size);
+
+    if (num_bytes == SIZE_MAX) {
+        return NULL;
+    }
+
+    return ctx->allocator.alloc(num_bytes, ctx->allocator.user);
+}
+
+static void ctx_free(WingContext *ctx, void *ptr) {
+    if (ptr != NULL) {
+        ctx->allocator.free(ptr, ctx->allocator.user);
+    }
+}
+
+WingContext *wingstl_create(const Allocator *allocator) {
+    Allocator fallback = {default_alloc, default_free, NULL};
+
+    if (allocator == NULL || allocator->alloc == NULL || allocator->free == NULL) {
+        allocator = &fallback;
+    }
+
+    WingContext *ctx = (WingContext *) allocator->alloc(sizeof(WingContext), allocator->user);
+
+    if (ctx == NULL) {
+        fprintf(stderr, "wingstl: error: unable to allocate memory for context\n");
+        return NULL;
+    }
+
+    memset(ctx, 0, sizeof(WingContext));
+    ctx->allocator = *allocator;
+    init_settings(&ctx->settings);
+
+    return ctx;
+}
+
+void wingstl_reset(WingContext *ctx) {
+    ctx_free(ctx, ctx->pts);
+    ctx_free(ctx, ctx->slice_pts);
+    ctx_free(ctx, ctx->indices);
+    ctx_free(ctx, ctx->slice_indices);
+    ctx_free(ctx, ctx->writer.data);
+
+    free_profile(&ctx->profile);
+    free_settings(&ctx->settings);
+
+    Allocator allocator = ctx->allocator;
+
+    memset(ctx, 0, sizeof(WingContext));
+    ctx->allocator = allocator;
+    init_settings(&ctx->settings);
+}
+
+void wingstl_destroy(WingContext *ctx) {
+    if (ctx == NULL) {
+        return;
+    }
+
+    wingstl_reset(ctx);
+    free_settings(&ctx->settings);
+    ctx->allocator.free(ctx, ctx->allocator.user);
+}
+
+int wingstl_setup(WingContext *ctx, int num_args, char **args) {
+    wingstl_reset(ctx);
+
+    const char *unavailable[] = {FLAG_MANIFEST, FLAG_LIBRARY, FLAG_HELP, FLAG_REPORT, FLAG_ESTIMATE,
+                                 FLAG_MEMORY_BUDGET, FLAG_DISK_CHECK, FLAG_STORE};
+    int num_unavailable = (int) (sizeof(unavailable) / sizeof(unavailable[0]));
+
+    for (int i = 0; i < num_args; i++) {
+        for (int j = 0; j < num_unavailable; j++) {
+            if (strcmp(args[i], unavailable[j]) == 0) {
+                fprintf(stderr, "wingstl: error: flag ('%s') is not available through the library interface\n", args[i]);
+                return 1;
+            }
+        }
+    }
+
+    char **argv = (char **) ctx_alloc(ctx, (size_t) num_args + 2, sizeof(char *));
+
+    if (argv == NULL) {
+        fprintf(stderr, "wingstl: error: unable to allocate memory for arguments\n");
+        return 1;
+    }
+
+    argv[0] = "wingstl";
+    memcpy(argv + 1, args, num_args * sizeof(char *));
+    argv[num_args + 1] = NULL;
+
+    int status = handle_inputs(num_args + 1, argv, &ctx->settings) || validate_settings(&ctx->settings) ||
+                 select_chord_pts(&ctx->settings);
+    ctx_free(ctx, argv);
+
+    if (status) {
+        return 1;
+    }
+
+    ctx->num_tris = get_num_tris(&ctx->settings);
+    ctx->writer.capacity = WRITE_BUFFER_SIZE;
+    ctx->writer.data = (char *) ctx_alloc(ctx, ctx->writer.capacity, sizeof(char));
+
+    if (ctx->writer.data == NULL) {
+        fprintf(stderr, "wingstl: error: unable to allocate memory for output buffer\n");
+        return 1;
+    }
+
+    ctx->is_ready = true;
+    return 0;
+}
+
+int wingstl_num_slices(const WingContext *ctx) {
+    return ctx->is_ready ? ctx->settings.num_slices : 0;
+}
+
+size_t wingstl_num_pts(const WingContext *ctx) {
+    return ctx->is_ready ? get_num_pts(&ctx->settings) : 0;
+}
+
+size_t wingstl_num_tris(const WingContext *ctx) {
+    return ctx->is_ready ? ctx->num_tris : 0;
+}
+
+static int check_slice(const WingContext *ctx, int islice) {
+    if (!ctx->is_ready) {
+        fprintf(stderr, "wingstl: error: context has not been set up\n");
+        return 1;
+    }
+
+    if (islice < 0 || islice >= ctx->settings.num_slices) {
+        fprintf(stderr, "wingstl: error: slice %d is out of range\n", islice);
+        return 1;
+    }
+
+    return 0;
+}
+
+int wingstl_make_pts(WingContext *ctx, const Vec3D **pts, size_t *num_pts) {
+    if (!ctx->is_ready) {
+        fprintf(stderr, "wingstl: error: context has not been set up\n");
+        return 1;
+    }
+
+    if (ctx->pts == NULL) {
+        ctx->pts = (Vec3D *) ctx_alloc(ctx, get_num_pts(&ctx->settings), sizeof(Vec3D));
+
+        if (ctx->pts == NULL || fill_pts(&ctx->settings, ctx->pts)) {
+            fprintf(stderr, "wingstl: error: unable to allocate memory for vertices\n");
+            ctx_free(ctx, ctx->pts);
+            ctx->pts = NULL;
+            return 1;
+        }
+    }
+
+    if (pts != NULL) *pts = ctx->pts;
+    if (num_pts != NULL) *num_pts = get_num_pts(&ctx->settings);
+
+    return 0;
+}
+
+int wingstl_make_indices(WingContext *ctx, int islice, const Index **indices, size_t *num_tris) {
+    if (check_slice(ctx, islice)) {
+        return 1;
+    }
+
+    if (get_num_pts(&ctx->settings) - 1 > MAX_INDEX) {
+        fprintf(stderr, "wingstl: error: mesh has too many vertices for %d-bit indices\n", INDEX_BITS);
+        return 1;
+    }
+
+    if (ctx->indices == NULL) {
+        ctx->indices = (Index *) ctx_alloc(ctx, 3 * ctx->num_tris, sizeof(Index));
+
+        if (ctx->indices == NULL) {
+            fprintf(stderr, "wingstl: error: unable to allocate memory for triangle indices\n");
+            return 1;
+        }
+    }
+
+    assign_indices(&ctx->settings, ctx->num_tris, islice, ctx->indices);
+
+    if (indices != NULL) *indices = ctx->indices;
+    if (num_tris != NULL) *num_tris = ctx->num_tris;
+
+    return 0;
+}
+
+static int make_slice_workspace(WingContext *ctx) {
+    if (ctx->slice_pts != NULL) {
+        return 0;
+    }
+
+    make_slice_settings(&ctx->settings, &ctx->slice_settings);
+
+    ctx->slice_indices = (Index *) ctx_alloc(ctx, 3 * ctx->num_tris, sizeof(Index));
+    ctx->slice_pts = (Vec3D *) ctx_alloc(ctx, get_num_pts(&ctx->slice_settings), sizeof(Vec3D));
+
+    if (ctx->slice_indices == NULL || ctx->slice_pts == NULL || make_profile(&ctx->settings, &ctx->profile)) {
+        fprintf(stderr, "wingstl: error: unable to allocate memory for slice workspace\n");
+
+        ctx_free(ctx, ctx->slice_indices);
+        ctx_free(ctx, ctx->slice_pts);
+
+        ctx->slice_indices = NULL;
+        ctx->slice_pts = NULL;
+        return 1;
+    }
+
+    assign_indices(&ctx->slice_settings, ctx->num_tris, 0, ctx->slice_indices);
+    return 0;
+}
+
+static int serialize_slice(WingContext *ctx, int islice) {
+    if (check_slice(ctx, islice)) {
+        return 1;
+    }
+
+    Vec3D *pts = NULL;
+    const Index *indices = NULL;
+    size_t num_pts = 0;
+
+    if (ctx->settings.stream || is_indexed(ctx->settings.format)) {
+        if (make_slice_workspace(ctx)) {
+            return 1;
+        }
+
+        make_slice_pts(&ctx->settings, &ctx->profile, islice, ctx->slice_pts);
+
+        pts = ctx->slice_pts;
+        indices = ctx->slice_indices;
+        num_pts = get_num_pts(&ctx->slice_settings);
+    } else {
+        if (wingstl_make_pts(ctx, NULL, NULL) || wingstl_make_indices(ctx, islice, &indices, NULL)) {
+            return 1;
+        }
+
+        pts = ctx->pts;
+        num_pts = get_num_pts(&ctx->settings);
+    }
+
+    return write_mesh(&ctx->settings, &ctx->writer, pts, num_pts, indices, ctx->num_tris, NULL);
+}
+
+int wingstl_serialize(WingContext *ctx, int islice, char *buffer, size_t capacity, size_t *size) {
+    Sink *sink = &ctx->writer.sink;
+
+    *sink = (Sink) {.kind = BUFFER_SINK, .target = buffer, .target_capacity = (buffer == NULL) ? 0 : capacity};
+
+    int status = serialize_slice(ctx, islice);
+
+    if (size != NULL) {
+        *size = sink->target_size;
+    }
+
+    status = status || sink->target_size > sink->target_capacity;
+    *sink = (Sink) {.kind = BUFFER_SINK};
+
+    return status;
+}
+
+int wingstl_serialize_alloc(WingContext *ctx, int islice, char **data, size_t *size) {
+    Sink *sink = &ctx->writer.sink;
+
+    *sink = (Sink) {.kind = MEMORY_SINK, .allocator = &ctx->allocator};
+
+    int status = serialize_slice(ctx, islice);
+
+    if (status) {
+        ctx_free(ctx, sink->target);
+        sink->target = NULL;
+        sink->target_size = 0;
+    }
+
+    *data = sink->target;
+    *size = sink->target_size;
+    *sink = (Sink) {.kind = BUFFER_SINK};
+
+    return status;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
@@ -7,6 +7,7 @@
 #include <string.h>
 
 #include "types.h"
+#include "utils.h"
 #include "engine.h"
 #include "messages.h"
 #include "constants.h"
@@ -18,11 +19,26 @@ void show_help(void) {
     printf("Options:\n");
     printf("  %s\t\tShow this help message and exit\n", FLAG_HELP);
     printf("  %s\t\tEnable verbose output\n", FLAG_VERBOSE);
+    printf("  %s\t\tSmooth .dat airfoils with a cubic spline instead of linear interpolation\n", FLAG_SPLINE);
+    printf("  %s\t\tStream slices one at a time to keep memory use constant\n", FLAG_STREAM);
+    printf("  %s\t\tEstimate output sizes, vertex and triangle counts and memory, then exit\n", FLAG_ESTIMATE);
+    printf("  %s\t\tRefuse to run if the output would not fit in the free disk space\n", FLAG_DISK_CHECK);
+    printf("  %s  INT\tMemory budget in MiB; refuse to run if the estimated peak is larger\n", FLAG_MEMORY_BUDGET);
     printf("  %s  INT\tNumber of desired spanwise slices for STL model (default: %d)\n", FLAG_NUM_SLICES, DEFAULT_NUM_SLICES);
     printf("  %s  INT\tNumber of points along the chord (default: %d)\n", FLAG_CHORD_PTS, DEFAULT_NUM_CHORD_PTS);
+    printf("  %s  INT\tNumber of worker threads (default: %d)\n", FLAG_NUM_THREADS, DEFAULT_NUM_THREADS);
     printf("  %s  STR\tNACA 4-digit airfoil code or airfoil .dat file name (required)\n", FLAG_AIRFOIL);
     printf("  %s  STR\tUnits (default: '%s')\n", FLAG_UNITS, DEFAULT_UNITS);
     printf("  %s  STR\tOutput file name (default: '%s')\n", FLAG_OUTPUT, DEFAULT_OUTPUT);
+    printf("  %s  STR\tAirfoil library directory or .tar archive that '%s' names are looked up in\n", FLAG_LIBRARY, FLAG_AIRFOIL);
+    printf("  %s  STR\tDirectory for caching parsed .dat airfoils between runs\n", FLAG_CACHE);
+    printf("  %s  STR\tDirectory for caching output files; identical wings are copied from it\n", FLAG_STORE);
+    printf("  %s  STR\tWrite a timing and throughput report to a JSON file, or '%s' to print a summary\n", FLAG_REPORT, REPORT_STDOUT);
+    printf("  %s  STR\tManifest file with one job of options per line, run in one process\n", FLAG_MANIFEST);
+    printf("  %s  STR\tOutput format, 'ascii', 'binary', 'ply', 'obj' or '3mf' (default: '%s')\n", FLAG_FORMAT, DEFAULT_FORMAT);
+    printf("  %s  STR\tChordwise station spacing, 'cosine', 'arc' or 'curvature' (default: '%s')\n", FLAG_SPACING, DEFAULT_SPACING);
+    printf("  %s  INT\tDecimal places in ASCII output, 0 for shortest round-trip (default: %d)\n", FLAG_DECIMALS, DEFAULT_DECIMALS);
+    printf("  %s  REAL\tMaximum chordal deviation in '%s' units; picks the fewest chordwise points that meet it\n", FLAG_TOLERANCE, FLAG_UNITS);
     printf("  %s  REAL\tSemi span length (required)\n", FLAG_SEMI_SPAN);
     printf("  %s  REAL\tRoot chord length (required)\n", FLAG_ROOT_CHORD);
     printf("  %s  REAL\tLeading edge sweep angle in degrees (default: %.0f)\n", FLAG_SWEEP_LE, DEFAULT_SWEEP_LE);
@@ -74,13 +90,40 @@ void show_settings(const Settings *settings) {
         printf("%s\n", settings->airfoil.header);
     }
 
+    if (settings->airfoil.num_pts > 0) {
+        printf("  Section interpolation:\t%s\n", (settings->use_spline ? "cubic spline" : "linear"));
+    }
+
     printf("  Full wing aspect ratio:\t%.2f\n", get_aspect_ratio(settings));
     printf("  Full wing surface area:\t%.2f sq %s\n", get_surface_area(settings), units);
     printf("  Leading edge sweep angle:\t%.2f deg\n", settings->sweep_angles[0]);
     printf("  Trailing edge sweep angle:\t%.2f deg\n", settings->sweep_angles[1]);
     printf("  Trailing edge configuration:\t%s\n", (settings->airfoil.has_closed_te ? "closed" : "open"));
     printf("  Chordwise points:\t\t%d\n", settings->num_pts_chord);
+
+    if (settings->tolerance > 0.0f) {
+        printf("  Chordal tolerance:\t\t%g %s\n", settings->tolerance, units);
+    }
+
+    printf("  Chordwise spacing:\t\t%s\n", get_spacing_name(settings->spacing));
     printf("  Number of slices:\t\t%d\n", settings->num_slices);
+    switch (settings->format) {
+        case BINARY_STL:
+            printf("  Output format:\t\tbinary STL\n");
+            break;
+        case BINARY_PLY:
+            printf("  Output format:\t\tbinary PLY\n");
+            break;
+        case ASCII_OBJ:
+            printf("  Output format:\t\tASCII OBJ\n");
+            break;
+        case THREE_MF:
+            printf("  Output format:\t\t3MF package\n");
+            break;
+        default:
+            printf("  Output format:\t\tASCII STL\n");
+            break;
+    }
 }
 
 /*
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "types.h"
+#include "parallel.h"
+
+typedef struct Pool {
+    pthread_mutex_t lock;
+    TaskFunc task;
+    ReportFunc report;
+    void *context;
+    int num_tasks;
+    int next_task;
+    int status;
+} Pool;
+
+typedef struct PoolWorker {
+    Pool *pool;
+    int iworker;
+} PoolWorker;
+
+void *work(void *arg) {
+    PoolWorker *worker = (PoolWorker *) arg;
+    Pool *pool = worker->pool;
+
+    int itask;
+    int status;
+
+    while (true) {
+        pthread_mutex_lock(&pool->lock);
+        itask = pool->status ? pool->num_tasks : pool->next_task++;
+        pthread_mutex_unlock(&pool->lock);
+
+        if (itask >= pool->num_tasks) {
+            break;
+        }
+
+        status = pool->task(pool->context, itask, worker->iworker);
+
+        pthread_mutex_lock(&pool->lock);
+
+        if (status) {
+            pool->status = 1;
+        } else if (pool->report != NULL) {
+            pool->report(pool->context, itask);
+        }
+
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    return NULL;
+}
+
+int run_serial(int num_tasks, TaskFunc task, ReportFunc report, void *context) {
+    for (int itask = 0; itask < num_tasks; itask++) {
+        if (task(context, itask, 0)) {
+            return 1;
+        }
+
+        if (report != NULL) {
+            report(context, itask);
+        }
+    }
+
+    return 0;
+}
+
+int run_parallel(int num_workers, int num_tasks, TaskFunc task, ReportFunc report, void *context) {
+    if (num_workers > num_tasks) {
+        num_workers = num_tasks;
+    }
+
+    if (num_workers <= 1) {
+        return run_serial(num_tasks, task, report, context);
+    }
+
+    pthread_t *threads = (pthread_t *) malloc((num_workers - 1) * sizeof(pthread_t));
+    PoolWorker *workers = (PoolWorker *) malloc(num_workers * sizeof(PoolWorker));
+
+    if (threads == NULL || workers == NULL) {
+        free(threads);
+        free(workers);
+
+        return run_serial(num_tasks, task, report, context);
+    }
+
+    Pool pool = {
+        .task = task, .report = report, .context = context,
+        .num_tasks = num_tasks, .next_task = 0, .status = 0
+    };
+
+    pthread_mutex_init(&pool.lock, NULL);
+
+    int num_started = 0;
+
+    for (int i = 1; i < num_workers; i++) {
+        workers[i].pool = &pool;
+        workers[i].iworker = i;
+
+        if (pthread_create(threads + num_started, NULL, work, workers + i) != 0) {
+            break;
+        }
+
+        num_started++;
+    }
+
+    workers[0].pool = &pool;
+    workers[0].iworker = 0;
+    work(workers);
+
+    for (int i = 0; i < num_started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&pool.lock);
+    free(threads);
+    free(workers);
+
+    return pool.status;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
@@ -10,7 +10,11 @@
 #include <ctype.h>
 
 #include "types.h"
+#include "sink.h"
 #include "utils.h"
+#include "cache.h"
+#include "library.h"
+#include "engine.h"
 #include "fileio.h"
 #include "parsing.h"
 #include "constants.h"
@@ -81,6 +85,101 @@ Units handle_units(int iarg, int num_args, char **args) {
     return units;
 }
 
+Format handle_format(int iarg, int num_args, char **args) {
+    Format format = UNKNOWN_FORMAT;
+
+    if (iarg + 1 < num_args) {
+        format = to_format(args[iarg + 1]);
+
+        if (format == UNKNOWN_FORMAT) {
+            fprintf(stderr, "wingstl: error: valid options for output format (flag '%s') are: ", FLAG_FORMAT);
+
+            for (int i = ASCII_STL; i < UNKNOWN_FORMAT; i++) {
+                const char *separator = (i == ASCII_STL) ? "" : (i + 1 == UNKNOWN_FORMAT) ? " or " : ", ";
+                fprintf(stderr, "%s'%s'", separator, get_format_name((Format) i));
+            }
+
+            fprintf(stderr, "\n");
+
+            return UNKNOWN_FORMAT;
+        }
+
+    } else {
+        request_value("output format", FLAG_FORMAT);
+
+        return UNKNOWN_FORMAT;
+    }
+
+    return format;
+}
+
+Spacing handle_spacing(int iarg, int num_args, char **args) {
+    Spacing spacing = UNKNOWN_SPACING;
+
+    if (iarg + 1 < num_args) {
+        spacing = to_spacing(args[iarg + 1]);
+
+        if (spacing == UNKNOWN_SPACING) {
+            fprintf(stderr, "wingstl: error: valid options for chordwise spacing (flag '%s') are: ", FLAG_SPACING);
+            fprintf(stderr, "'cosine', 'arc' or 'curvature'\n");
+
+            return UNKNOWN_SPACING;
+        }
+
+    } else {
+        request_value("chordwise spacing", FLAG_SPACING);
+
+        return UNKNOWN_SPACING;
+    }
+
+    return spacing;
+}
+
+char *handle_manifest(int iarg, int num_args, char **args) {
+    if (iarg + 1 < num_args) {
+        return args[iarg + 1];
+    }
+
+    request_value("manifest file", FLAG_MANIFEST);
+    return NULL;
+}
+
+char *handle_library(int iarg, int num_args, char **args) {
+    if (iarg + 1 < num_args) {
+        return args[iarg + 1];
+    }
+
+    request_value("airfoil library directory or .tar archive", FLAG_LIBRARY);
+    return NULL;
+}
+
+char *handle_cache_dir(int iarg, int num_args, char **args) {
+    if (iarg + 1 < num_args) {
+        return args[iarg + 1];
+    }
+
+    request_value("cache directory", FLAG_CACHE);
+    return NULL;
+}
+
+char *handle_store_dir(int iarg, int num_args, char **args) {
+    if (iarg + 1 < num_args) {
+        return args[iarg + 1];
+    }
+
+    request_value("output cache directory", FLAG_STORE);
+    return NULL;
+}
+
+char *handle_report(int iarg, int num_args, char **args) {
+    if (iarg + 1 < num_args) {
+        return args[iarg + 1];
+    }
+
+    request_value("report file or '" REPORT_STDOUT "'", FLAG_REPORT);
+    return NULL;
+}
+
 char *handle_output(int iarg, int num_args, char **args) {
     char *output = NULL;
 
@@ -89,7 +188,7 @@ char *handle_output(int iarg, int num_args, char **args) {
         int len = strlen(arg);
 
         bool is_dir = (arg[len - 1] == '\\') || (arg[len - 1] == '/');
-        bool has_stl_ext = has_ext(arg, ".stl") || has_ext(arg, ".STL");
+        bool has_stl_ext = has_mesh_ext(arg) || to_sink_kind(arg) != FILE_SINK;
 
         if (is_dir) {
             len += strlen(DEFAULT_OUTPUT);
@@ -122,15 +221,28 @@ char *handle_output(int iarg, int num_args, char **args) {
     return output;
 }
 
-void handle_airfoil(int iarg, int num_args, char **args, Airfoil *airfoil) {
+void handle_airfoil(int iarg, int num_args, char **args, Airfoil *airfoil, const Settings *settings) {
+    free_airfoil(airfoil);
     airfoil->num_pts = -1;
 
     if (iarg + 1 < num_args) {
         char *arg = args[iarg + 1];
         bool has_dat_ext = has_ext(arg, ".dat") || has_ext(arg, ".DAT");
 
+        if (settings->library.path != NULL) {
+            const LibraryEntry *entry = find_entry(&settings->library, arg);
+
+            if (entry != NULL) {
+                if (select_entry(&settings->library, entry, airfoil, settings->cache_dir)) {
+                    airfoil->num_pts = -1;
+                }
+
+                return;
+            }
+        }
+
         if (has_dat_ext) {
-            if (!read_dat(arg, airfoil)) {
+            if (!load_dat(arg, airfoil, settings->cache_dir, false)) {
                 return;
             }
 
@@ -177,6 +289,13 @@ void handle_airfoil(int iarg, int num_args, char **args, Airfoil *airfoil) {
             f = fopen(output, "r");
         }
         
+        if (f == NULL && settings->library.path != NULL) {
+            fprintf(stderr, "wingstl: error: airfoil '%s' not found in library '%s'\n", arg, settings->library.path);
+            airfoil->num_pts = -1;
+            free(output);
+            return;
+        }
+
         if (f == NULL) {
             fprintf(stderr, "wingstl: error: argument for flag '%s' must be either a ", FLAG_AIRFOIL);
             fprintf(stderr, "4-digit naca code or a valid .dat file name\n");
@@ -187,7 +306,7 @@ void handle_airfoil(int iarg, int num_args, char **args, Airfoil *airfoil) {
 
         fclose(f);
 
-        if (!read_dat(output, airfoil)) {
+        if (!load_dat(output, airfoil, settings->cache_dir, false)) {
             free(output);
             return;
         }
@@ -208,7 +327,8 @@ int handle_chord_pts(int iarg, int num_args, char **args) {
 
     if (iarg + 1 < num_args) {
         char *arg = args[iarg + 1];
-        num_pts = atoi(arg);
+        long value = strtol(arg, NULL, 10);
+        num_pts = (value < 0) ? -1 : (value > MAX_CHORD_PTS) ? MAX_CHORD_PTS + 1 : (int) value;
 
         if (num_pts < MIN_CHORD_PTS) {
             request_bounded_integer(desc, FLAG_CHORD_PTS, MIN_CHORD_PTS, "at least");
@@ -234,7 +354,8 @@ int handle_num_slices(int iarg, int num_args, char **args) {
 
     if (iarg + 1 < num_args) {
         char *arg = args[iarg + 1];
-        num_slices = atoi(arg);
+        long value = strtol(arg, NULL, 10);
+        num_slices = (value < 0) ? -1 : (value > MAX_NUM_SLICES) ? MAX_NUM_SLICES + 1 : (int) value;
 
         if (num_slices < MIN_NUM_SLICES) {
             request_bounded_integer(desc, FLAG_NUM_SLICES, MIN_NUM_SLICES, "at least");
@@ -254,6 +375,84 @@ int handle_num_slices(int iarg, int num_args, char **args) {
     return num_slices;
 }
 
+int handle_num_threads(int iarg, int num_args, char **args) {
+    int num_threads = -1;
+    char desc[] = "number of worker threads";
+
+    if (iarg + 1 < num_args) {
+        char *arg = args[iarg + 1];
+        num_threads = atoi(arg);
+
+        if (num_threads < MIN_THREADS) {
+            request_bounded_integer(desc, FLAG_NUM_THREADS, MIN_THREADS, "at least");
+            return -1;
+        }
+
+        if (num_threads > MAX_THREADS) {
+            request_bounded_integer(desc, FLAG_NUM_THREADS, MAX_THREADS, "at most");
+            return -1;
+        }
+
+    } else {
+        request_value(desc, FLAG_NUM_THREADS);
+        return -1;
+    }
+
+    return num_threads;
+}
+
+int handle_memory_budget(int iarg, int num_args, char **args) {
+    int memory_budget = -1;
+    char desc[] = "memory budget in MiB";
+
+    if (iarg + 1 < num_args) {
+        char *arg = args[iarg + 1];
+        memory_budget = atoi(arg);
+
+        if (memory_budget < MIN_MEMORY_BUDGET) {
+            request_bounded_integer(desc, FLAG_MEMORY_BUDGET, MIN_MEMORY_BUDGET, "at least");
+            return -1;
+        }
+
+        if (memory_budget > MAX_MEMORY_BUDGET) {
+            request_bounded_integer(desc, FLAG_MEMORY_BUDGET, MAX_MEMORY_BUDGET, "at most");
+            return -1;
+        }
+
+    } else {
+        request_value(desc, FLAG_MEMORY_BUDGET);
+        return -1;
+    }
+
+    return memory_budget;
+}
+
+int handle_decimals(int iarg, int num_args, char **args) {
+    int decimals = -1;
+    char desc[] = "number of decimal places";
+
+    if (iarg + 1 < num_args) {
+        char *arg = args[iarg + 1];
+        decimals = atoi(arg);
+
+        if (decimals < MIN_DECIMALS) {
+            request_bounded_integer(desc, FLAG_DECIMALS, MIN_DECIMALS, "at least");
+            return -1;
+        }
+
+        if (decimals > MAX_DECIMALS) {
+            request_bounded_integer(desc, FLAG_DECIMALS, MAX_DECIMALS, "at most");
+            return -1;
+        }
+
+    } else {
+        request_value(desc, FLAG_DECIMALS);
+        return -1;
+    }
+
+    return decimals;
+}
+
 float handle_sweep(int iarg, int num_args, char **args, const char *arg_flag) {
     char desc[32];
     float sweep = -1.0f;
@@ -288,6 +487,67 @@ float handle_sweep(int iarg, int num_args, char **args, const char *arg_flag) {
     return sweep;
 }
 
+void init_settings(Settings *settings) {
+    Settings defaults = {
+        .units = to_units(DEFAULT_UNITS),
+        .format = to_format(DEFAULT_FORMAT),
+        .spacing = to_spacing(DEFAULT_SPACING),
+        .airfoil = {DEFAULT_AIRFOIL},
+        .semi_span = DEFAULT_SEMI_SPAN,
+        .num_slices = DEFAULT_NUM_SLICES,
+        .root_chord = DEFAULT_ROOT_CHORD,
+        .sweep_angles = {DEFAULT_SWEEP_LE, DEFAULT_SWEEP_TE},
+        .tolerance = DEFAULT_TOLERANCE,
+        .decimals = DEFAULT_DECIMALS,
+        .num_threads = DEFAULT_NUM_THREADS,
+        .num_pts_chord = DEFAULT_NUM_CHORD_PTS,
+        .verbose = false, .help = false, .use_spline = false, .stream = false,
+        .estimate = false, .check_disk = false, .memory_budget = 0,
+        .output = NULL, .manifest = NULL, .cache_dir = NULL, .store_dir = NULL, .report = NULL, .library = {0}
+    };
+
+    *settings = defaults;
+}
+
+void free_settings(Settings *settings) {
+    free_airfoil(&settings->airfoil);
+    free_library(&settings->library);
+    free(settings->output);
+
+    settings->output = NULL;
+}
+
+int handle_output_ext(Settings *settings) {
+    if (settings->output == NULL) {
+        settings->output = (char *) malloc((strlen(DEFAULT_OUTPUT) + 1) * sizeof(char));
+
+        if (settings->output == NULL) {
+            fprintf(stderr, "wingstl: error: unable to allocate memory for file output\n");
+            return 1;
+        }
+
+        strcpy(settings->output, DEFAULT_OUTPUT);
+    }
+
+    if (to_sink_kind(settings->output) != FILE_SINK) {
+        return 0;
+    }
+
+    const char *ext = get_format_ext(settings->format);
+    char *dot = settings->output + strlen(settings->output) - strlen(ext);
+    bool has_format_ext = true;
+
+    for (int i = 0; ext[i] != '\0'; i++) {
+        has_format_ext = has_format_ext && tolower((unsigned char) dot[i]) == ext[i];
+    }
+
+    if (!has_format_ext) {
+        strcpy(dot, ext);
+    }
+
+    return 0;
+}
+
 int handle_inputs(int num_args, char **args, Settings *settings) {
     if (num_args < 2) {
         fprintf(stderr, "wingstl: error: missing required arguments; use flag ('%s') for help\n", FLAG_HELP);
@@ -296,6 +556,27 @@ int handle_inputs(int num_args, char **args, Settings *settings) {
 
     char *arg = NULL;
 
+    int ilibrary = -1;
+    int ithreads = -1;
+
+    for (int i = 1; i + 1 < num_args; i++) {
+        if (strcmp(args[i], FLAG_CACHE) == 0) {
+            settings->cache_dir = args[++i];
+        } else if (strcmp(args[i], FLAG_LIBRARY) == 0) {
+            ilibrary = i++;
+        } else if (strcmp(args[i], FLAG_NUM_THREADS) == 0) {
+            ithreads = i++;
+        }
+    }
+
+    if (ilibrary >= 0 && settings->library.path == NULL) {
+        int num_threads = (ithreads >= 0) ? handle_num_threads(ithreads, num_args, args) : settings->num_threads;
+
+        if (num_threads < 0 || load_library(args[ilibrary + 1], &settings->library, settings->cache_dir, num_threads)) {
+            return 1;
+        }
+    }
+
     for (int i = 1; i < num_args; i++) {
         arg = args[i];
 
@@ -307,10 +588,45 @@ int handle_inputs(int num_args, char **args, Settings *settings) {
         if (strcmp(arg, FLAG_VERBOSE) == 0) {
             settings->verbose = true;
 
+        } else if (strcmp(arg, FLAG_SPLINE) == 0) {
+            settings->use_spline = true;
+
+        } else if (strcmp(arg, FLAG_STREAM) == 0) {
+            settings->stream = true;
+
+        } else if (strcmp(arg, FLAG_ESTIMATE) == 0) {
+            settings->estimate = true;
+
+        } else if (strcmp(arg, FLAG_DISK_CHECK) == 0) {
+            settings->check_disk = true;
+
+        } else if (strcmp(arg, FLAG_MEMORY_BUDGET) == 0) {
+            settings->memory_budget = handle_memory_budget(i, num_args, args);
+            if (settings->memory_budget < 0) { return 1; } else { i++; }
+
         } else if (strcmp(arg, FLAG_HELP) == 0) {
             settings->help = true;
             return 1;
 
+        } else if (strcmp(arg, FLAG_MANIFEST) == 0) {
+            settings->manifest = handle_manifest(i, num_args, args);
+            if (settings->manifest == NULL) { return 1; } else { i++; }
+
+        } else if (strcmp(arg, FLAG_LIBRARY) == 0) {
+            if (handle_library(i, num_args, args) == NULL) { return 1; } else { i++; }
+
+        } else if (strcmp(arg, FLAG_CACHE) == 0) {
+            settings->cache_dir = handle_cache_dir(i, num_args, args);
+            if (settings->cache_dir == NULL) { return 1; } else { i++; }
+
+        } else if (strcmp(arg, FLAG_STORE) == 0) {
+            settings->store_dir = handle_store_dir(i, num_args, args);
+            if (settings->store_dir == NULL) { return 1; } else { i++; }
+
+        } else if (strcmp(arg, FLAG_REPORT) == 0) {
+            settings->report = handle_report(i, num_args, args);
+            if (settings->report == NULL) { return 1; } else { i++; }
+
         } else if (strcmp(arg, FLAG_OUTPUT) == 0) {
             settings->output = handle_output(i, num_args, args);
             if (settings->output == NULL) { return 1; } else { i++; }
@@ -323,8 +639,12 @@ int handle_inputs(int num_args, char **args, Settings *settings) {
             settings->root_chord = handle_nonzero_positive(i, num_args, args, "root chord", FLAG_ROOT_CHORD);
             if (settings->root_chord < 0.0f) { return 1; } else { i++; }
 
+        } else if (strcmp(arg, FLAG_TOLERANCE) == 0) {
+            settings->tolerance = handle_nonzero_positive(i, num_args, args, "chordal tolerance", FLAG_TOLERANCE);
+            if (settings->tolerance < 0.0f) { return 1; } else { i++; }
+
         } else if (strcmp(arg, FLAG_AIRFOIL) == 0) {
-            handle_airfoil(i, num_args, args, &settings->airfoil);
+            handle_airfoil(i, num_args, args, &settings->airfoil, settings);
             if (settings->airfoil.num_pts < 0) { return 1; } else { i++; }
             
         } else if (strcmp(arg, FLAG_CHORD_PTS) == 0) {
@@ -347,13 +667,29 @@ int handle_inputs(int num_args, char **args, Settings *settings) {
             settings->units = handle_units(i, num_args, args);
             if (settings->units == UNKNOWN_UNITS) { return 1; } else { i++; }
 
+        } else if (strcmp(arg, FLAG_FORMAT) == 0) {
+            settings->format = handle_format(i, num_args, args);
+            if (settings->format == UNKNOWN_FORMAT) { return 1; } else { i++; }
+
+        } else if (strcmp(arg, FLAG_SPACING) == 0) {
+            settings->spacing = handle_spacing(i, num_args, args);
+            if (settings->spacing == UNKNOWN_SPACING) { return 1; } else { i++; }
+
+        } else if (strcmp(arg, FLAG_DECIMALS) == 0) {
+            settings->decimals = handle_decimals(i, num_args, args);
+            if (settings->decimals < 0) { return 1; } else { i++; }
+
+        } else if (strcmp(arg, FLAG_NUM_THREADS) == 0) {
+            settings->num_threads = handle_num_threads(i, num_args, args);
+            if (settings->num_threads < 0) { return 1; } else { i++; }
+
         } else {
             fprintf(stderr, "wingstl: error: unrecognized argument flag '%s'\n", arg);
             return 1;
         }
     }
 
-    return 0;
+    return handle_output_ext(settings);
 }
 
 /*
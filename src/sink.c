@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <ctype.h>
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#include "sink.h"
+#include "types.h"
+#include "constants.h"
+
+SinkKind to_sink_kind(const char *output) {
+    if (output == NULL) {
+        return FILE_SINK;
+    }
+
+    if (strcmp(output, OUTPUT_STDOUT) == 0) {
+        return STDOUT_SINK;
+    }
+
+    if (strncmp(output, OUTPUT_FD_PREFIX, strlen(OUTPUT_FD_PREFIX)) == 0) {
+        return FD_SINK;
+    }
+
+    return FILE_SINK;
+}
+
+int get_sink_fd(const char *output) {
+    const char *digits = output + strlen(OUTPUT_FD_PREFIX);
+
+    if (*digits == '\0') {
+        return -1;
+    }
+
+    long fd = 0;
+
+    for (const char *c = digits; *c != '\0'; c++) {
+        if (!isdigit((unsigned char) *c) || fd > INT_MAX / 10) {
+            return -1;
+        }
+
+        fd = 10 * fd + (*c - '0');
+    }
+
+    return (fd > INT_MAX) ? -1 : (int) fd;
+}
+
+int open_sink(Sink *sink, const char *fname) {
+    sink->target_size = 0;
+
+    if (sink->kind == BUFFER_SINK || sink->kind == MEMORY_SINK) {
+        return 0;
+    }
+
+    sink->kind = to_sink_kind(fname);
+
+    switch (sink->kind) {
+        case STDOUT_SINK:
+            fflush(stdout);
+            sink->fd = STDOUT_FILENO;
+            return 0;
+        case FD_SINK:
+            sink->fd = get_sink_fd(fname);
+            sink->fd = (sink->fd >= 0 && fcntl(sink->fd, F_GETFD) != -1) ? sink->fd : -1;
+            break;
+        default:
+            sink->fd = open(fname, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+            break;
+    }
+
+    if (sink->fd < 0) {
+        fprintf(stderr, "wingstl: error: unable to open output file for writing\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+int grow_target(Sink *sink, size_t num_bytes) {
+    size_t capacity = (sink->target_capacity > 0) ? sink->target_capacity : WRITE_BUFFER_SIZE;
+
+    while (capacity < num_bytes) {
+        capacity = (capacity > SIZE_MAX / 2) ? num_bytes : 2 * capacity;
+    }
+
+    char *target = NULL;
+
+    if (sink->allocator == NULL) {
+        target = (char *) realloc(sink->target, capacity);
+    } else {
+        target = (char *) sink->allocator->alloc(capacity, sink->allocator->user);
+
+        if (target != NULL && sink->target != NULL) {
+            memcpy(target, sink->target, sink->target_size);
+            sink->allocator->free(sink->target, sink->allocator->user);
+        }
+    }
+
+    if (target == NULL) {
+        fprintf(stderr, "wingstl: error: unable to allocate memory for output buffer\n");
+        return 1;
+    }
+
+    sink->target = target;
+    sink->target_capacity = capacity;
+
+    return 0;
+}
+
+int write_sink(Sink *sink, struct iovec *iov, int iovcnt) {
+    if (sink->kind == BUFFER_SINK || sink->kind == MEMORY_SINK) {
+        for (int i = 0; i < iovcnt; i++) {
+            size_t num_bytes = sink->target_size + iov[i].iov_len;
+
+            if (sink->kind == MEMORY_SINK && num_bytes > sink->target_capacity && grow_target(sink, num_bytes)) {
+                return 1;
+            }
+
+            if (iov[i].iov_len > 0 && num_bytes <= sink->target_capacity) {
+                memcpy(sink->target + sink->target_size, iov[i].iov_base, iov[i].iov_len);
+            }
+
+            sink->target_size = num_bytes;
+        }
+
+        return 0;
+    }
+
+    while (iovcnt > 0) {
+        ssize_t num_written = writev(sink->fd, iov, iovcnt);
+
+        if (num_written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            fprintf(stderr, "wingstl: error: unable to write to output file\n");
+            return 1;
+        }
+
+        sink->target_size += (size_t) num_written;
+
+        while (iovcnt > 0 && (size_t) num_written >= iov->iov_len) {
+            num_written -= (ssize_t) iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+
+        if (iovcnt > 0) {
+            iov->iov_base = (char *) iov->iov_base + num_written;
+            iov->iov_len -= (size_t) num_written;
+        }
+    }
+
+    return 0;
+}
+
+int close_sink(Sink *sink) {
+    if (sink->kind != FILE_SINK || sink->fd < 0) {
+        return 0;
+    }
+
+    int status = close(sink->fd);
+    sink->fd = -1;
+
+    if (status != 0) {
+        fprintf(stderr, "wingstl: error: unable to close output file\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <stdbool.h>
+
+#include "types.h"
+#include "engine.h"
+#include "spacing.h"
+#include "validation.h"
+#include "constants.h"
+
+void sample_section(const Settings *settings, const float *xs, int n, Vec2D *upper, Vec2D *lower) {
+    const Airfoil *airfoil = &settings->airfoil;
+    bool use_spline = settings->use_spline && airfoil->num_pts > 0;
+
+    for (int i = 0; i < n; i++) {
+        upper[i].x = get_surface_x(xs[i], airfoil, true);
+        lower[i].x = get_surface_x(xs[i], airfoil, false);
+
+        if (use_spline) {
+            upper[i].y = get_spline_z(xs[i], airfoil, true);
+            lower[i].y = get_spline_z(xs[i], airfoil, false);
+        } else {
+            upper[i].y = get_surface_z(xs[i], airfoil, true);
+            lower[i].y = get_surface_z(xs[i], airfoil, false);
+        }
+    }
+}
+
+float get_distance(const Vec2D *a, const Vec2D *b) {
+    float dx = b->x - a->x;
+    float dy = b->y - a->y;
+
+    return sqrtf(dx * dx + dy * dy);
+}
+
+float get_curvature(const Vec2D *a, const Vec2D *b, const Vec2D *c) {
+    float ab = get_distance(a, b);
+    float bc = get_distance(b, c);
+    float ca = get_distance(c, a);
+    float area2 = (b->x - a->x) * (c->y - a->y) - (b->y - a->y) * (c->x - a->x);
+    float denom = ab * bc * ca;
+
+    return (denom > FLT_EPSILON * FLT_EPSILON) ? 2.0f * fabsf(area2) / denom : 0.0f;
+}
+
+float get_point_curvature(const Vec2D *pts, const Vec2D *other, int k, int n) {
+    if (k == n - 1) {
+        k = n - 2;
+    }
+
+    const Vec2D *prev = (k == 0) ? other + 1 : pts + k - 1;
+
+    return get_curvature(prev, pts + k, pts + k + 1);
+}
+
+void get_spacing_weights(const Settings *settings, const Vec2D *upper, const Vec2D *lower, int n, float *weights) {
+    const Vec2D *pts, *other;
+    float density;
+
+    for (int k = 0; k < n - 1; k++) {
+        weights[k] = 0.0f;
+
+        for (int is_upper = 1; is_upper >= 0; is_upper--) {
+            pts = is_upper ? upper : lower;
+            other = is_upper ? lower : upper;
+            density = 1.0f;
+
+            if (settings->spacing == CURVATURE_SPACING) {
+                density = 0.5f * (sqrtf(get_point_curvature(pts, other, k, n)) +
+                                  sqrtf(get_point_curvature(pts, other, k + 1, n)));
+            }
+
+            weights[k] += density * get_distance(pts + k, pts + k + 1);
+        }
+    }
+}
+
+void invert_weights(const float *xs, float *weights, int num_samples, float *stations, int n) {
+    double total = 0.0;
+
+    for (int k = 0; k < num_samples - 1; k++) {
+        total += weights[k];
+    }
+
+    float floor = (float) (SPACING_COSINE_SHARE * total / (num_samples - 1));
+
+    total = 0.0;
+
+    for (int k = 0; k < num_samples - 1; k++) {
+        weights[k] = (weights[k] < floor) ? floor : weights[k];
+        total += weights[k];
+    }
+
+    double cum = 0.0;
+    double target, frac;
+
+    int k = 0;
+
+    stations[0] = xs[0];
+
+    for (int i = 1; i < n - 1; i++) {
+        target = total * i / (n - 1);
+
+        while (k < num_samples - 2 && cum + weights[k] < target) {
+            cum += weights[k++];
+        }
+
+        frac = (weights[k] > 0.0f) ? (target - cum) / weights[k] : 0.0;
+        frac = (frac < 0.0) ? 0.0 : (frac > 1.0) ? 1.0 : frac;
+
+        stations[i] = xs[k] + (float) frac * (xs[k + 1] - xs[k]);
+    }
+
+    stations[n - 1] = xs[num_samples - 1];
+}
+
+int fill_stations(const Settings *settings, float *stations, int n) {
+    if (settings->spacing == COSINE_SPACING) {
+        for (int i = 0; i < n; i++) {
+            stations[i] = (1.0f - cosf(((float) i / (n - 1)) * PI)) / 2.0f;
+        }
+
+        return 0;
+    }
+
+    int num_samples = SPACING_SAMPLES;
+
+    float *xs = (float *) malloc(num_samples * sizeof(float));
+    float *weights = (float *) malloc(num_samples * sizeof(float));
+    Vec2D *upper = (Vec2D *) malloc(num_samples * sizeof(Vec2D));
+    Vec2D *lower = (Vec2D *) malloc(num_samples * sizeof(Vec2D));
+
+    if (xs == NULL || weights == NULL || upper == NULL || lower == NULL) {
+        free(xs);
+        free(weights);
+        free(upper);
+        free(lower);
+        return 1;
+    }
+
+    for (int k = 0; k < num_samples; k++) {
+        xs[k] = (1.0f - cosf(((float) k / (num_samples - 1)) * PI)) / 2.0f;
+    }
+
+    xs[0] = 0.0f;
+    xs[num_samples - 1] = 1.0f;
+
+    sample_section(settings, xs, num_samples, upper, lower);
+    get_spacing_weights(settings, upper, lower, num_samples, weights);
+    invert_weights(xs, weights, num_samples, stations, n);
+
+    free(xs);
+    free(weights);
+    free(upper);
+    free(lower);
+
+    return 0;
+}
+
+float get_segment_distance(const Vec2D *p, const Vec2D *a, const Vec2D *b) {
+    float dx = b->x - a->x;
+    float dy = b->y - a->y;
+    float length2 = dx * dx + dy * dy;
+    float t = (length2 > 0.0f) ? ((p->x - a->x) * dx + (p->y - a->y) * dy) / length2 : 0.0f;
+
+    t = (t < 0.0f) ? 0.0f : (t > 1.0f) ? 1.0f : t;
+
+    Vec2D nearest = {a->x + t * dx, a->y + t * dy};
+
+    return get_distance(p, &nearest);
+}
+
+int get_max_deviation(const Settings *settings, int n, float *deviation) {
+    int num_sub = DEVIATION_SAMPLES;
+    int num_mid = (n - 1) * (num_sub - 1);
+
+    float *stations = NULL;
+    float *xs = NULL;
+    Vec2D *pts = NULL;
+
+    stations = (float *) malloc(n * sizeof(float));
+    xs = (float *) calloc(num_mid, sizeof(float));
+    pts = (Vec2D *) malloc(2 * ((size_t) n + num_mid) * sizeof(Vec2D));
+
+    if (stations == NULL || xs == NULL || pts == NULL || fill_stations(settings, stations, n)) {
+        free(stations);
+        free(xs);
+        free(pts);
+        return 1;
+    }
+
+    Vec2D *upper = pts;
+    Vec2D *lower = upper + n;
+    Vec2D *mid_upper = lower + n;
+    Vec2D *mid_lower = mid_upper + num_mid;
+
+    for (int i = 0; i < n - 1; i++) {
+        for (int m = 1; m < num_sub; m++) {
+            xs[i * (num_sub - 1) + m - 1] = stations[i] + (stations[i + 1] - stations[i]) * m / num_sub;
+        }
+    }
+
+    sample_section(settings, stations, n, upper, lower);
+    sample_section(settings, xs, num_mid, mid_upper, mid_lower);
+
+    float distance;
+    int k;
+
+    *deviation = 0.0f;
+
+    for (int i = 0; i < n - 1; i++) {
+        for (int m = 1; m < num_sub; m++) {
+            k = i * (num_sub - 1) + m - 1;
+
+            distance = get_segment_distance(mid_upper + k, upper + i, upper + i + 1);
+            *deviation = (distance > *deviation) ? distance : *deviation;
+
+            distance = get_segment_distance(mid_lower + k, lower + i, lower + i + 1);
+            *deviation = (distance > *deviation) ? distance : *deviation;
+        }
+    }
+
+    free(stations);
+    free(xs);
+    free(pts);
+
+    return 0;
+}
+
+int meets_tolerance(const Settings *settings, int n, float tolerance, bool *is_met) {
+    float deviation;
+
+    if (get_max_deviation(settings, n, &deviation)) {
+        fprintf(stderr, "wingstl: error: unable to allocate memory for chordal deviation estimate\n");
+        return 1;
+    }
+
+    *is_met = (deviation <= tolerance);
+
+    return 0;
+}
+
+int select_chord_pts(Settings *settings) {
+    if (settings->tolerance <= 0.0f) {
+        return 0;
+    }
+
+    float tolerance = settings->tolerance / get_max_chord(settings);
+
+    int lo = MIN_CHORD_PTS;
+    int hi = MIN_CHORD_PTS;
+    bool is_met;
+
+    if (meets_tolerance(settings, hi, tolerance, &is_met)) {
+        return 1;
+    }
+
+    while (!is_met) {
+        if (hi >= MAX_TOLERANCE_PTS) {
+            fprintf(stderr, "wingstl: error: chordal tolerance (flag '%s') cannot be met with %d chordwise points; ", FLAG_TOLERANCE, MAX_TOLERANCE_PTS);
+            fprintf(stderr, "try a larger value\n");
+            return 1;
+        }
+
+        lo = hi;
+        hi = (2 * hi < MAX_TOLERANCE_PTS) ? 2 * hi : MAX_TOLERANCE_PTS;
+
+        if (meets_tolerance(settings, hi, tolerance, &is_met)) {
+            return 1;
+        }
+    }
+
+    int mid;
+
+    while (hi - lo > 1) {
+        mid = lo + (hi - lo) / 2;
+
+        if (meets_tolerance(settings, mid, tolerance, &is_met)) {
+            return 1;
+        }
+
+        if (is_met) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+
+    settings->num_pts_chord = hi;
+
+    return validate_mesh(settings);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
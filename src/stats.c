@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <time.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <sys/resource.h>
+
+#include "stats.h"
+#include "types.h"
+#include "constants.h"
+
+double get_wall_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double) ts.tv_sec + 1e-9 * (double) ts.tv_nsec;
+}
+
+double get_cpu_time(bool is_process) {
+    struct timespec ts;
+
+    if (clock_gettime(is_process ? CLOCK_PROCESS_CPUTIME_ID : CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0.0;
+    }
+
+    return (double) ts.tv_sec + 1e-9 * (double) ts.tv_nsec;
+}
+
+size_t get_peak_memory(void) {
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+
+#ifdef __APPLE__
+    return (size_t) usage.ru_maxrss;
+#else
+    return (size_t) usage.ru_maxrss * 1024;
+#endif
+}
+
+const char *get_stage_name(Stage stage) {
+    switch (stage) {
+        case STAGE_SETUP:
+            return "setup";
+        case STAGE_POINTS:
+            return "points";
+        case STAGE_INDICES:
+            return "indices";
+        case STAGE_FORMAT:
+            return "format";
+        case STAGE_WRITE:
+            return "write";
+        default:
+            return "unknown";
+    }
+}
+
+void start_timer(Timer *timer, bool is_process) {
+    timer->is_process = is_process;
+    timer->start.wall = get_wall_time();
+    timer->start.cpu = get_cpu_time(is_process);
+}
+
+void stop_timer(const Timer *timer, Stats *stats, Stage stage) {
+    if (stats == NULL) {
+        return;
+    }
+
+    stats->stages[stage].wall += get_wall_time() - timer->start.wall;
+    stats->stages[stage].cpu += get_cpu_time(timer->is_process) - timer->start.cpu;
+}
+
+void exclude_stage(Stats *stats, Stage stage, Stage nested, const StageTime *nested_before) {
+    if (stats == NULL) {
+        return;
+    }
+
+    stats->stages[stage].wall -= stats->stages[nested].wall - nested_before->wall;
+    stats->stages[stage].cpu -= stats->stages[nested].cpu - nested_before->cpu;
+}
+
+void add_stats(Stats *dst, const Stats *src) {
+    for (int i = 0; i < NUM_STAGES; i++) {
+        dst->stages[i].wall += src->stages[i].wall;
+        dst->stages[i].cpu += src->stages[i].cpu;
+    }
+
+    dst->num_pts += src->num_pts;
+    dst->num_tris += src->num_tris;
+    dst->num_bytes += src->num_bytes;
+    dst->num_files += src->num_files;
+}
+
+void show_report(const Stats *stats, const StageTime *total) {
+    double wall = (total->wall > 0.0) ? total->wall : 1e-9;
+
+    printf("Run report:\n");
+    printf("  %-12s%12s%12s\n", "Stage", "Wall (s)", "CPU (s)");
+
+    for (int i = 0; i < NUM_STAGES; i++) {
+        printf("  %-12s%12.6f%12.6f\n", get_stage_name((Stage) i), stats->stages[i].wall, stats->stages[i].cpu);
+    }
+
+    printf("  %-12s%12.6f%12.6f\n", "total", total->wall, total->cpu);
+    printf("  Vertices generated:\t%zu\n", stats->num_pts);
+    printf("  Triangles written:\t%zu\n", stats->num_tris);
+    printf("  Files written:\t%d\n", stats->num_files);
+    printf("  Bytes written:\t%zu\n", stats->num_bytes);
+    printf("  Throughput:\t\t%.0f triangles/s, %.2f MB/s\n", (double) stats->num_tris / wall, 1e-6 * (double) stats->num_bytes / wall);
+    printf("  Peak memory:\t\t%.2f MiB\n", (double) get_peak_memory() / (1024.0 * 1024.0));
+}
+
+int write_report(const char *fname, const Stats *stats, const StageTime *total, int status) {
+    FILE *f = fopen(fname, "w");
+
+    if (f == NULL) {
+        fprintf(stderr, "wingstl: error: unable to open report file '%s' for writing\n", fname);
+        return 1;
+    }
+
+    double wall = (total->wall > 0.0) ? total->wall : 1e-9;
+
+    fprintf(f, "{\n  \"status\": %d,\n  \"wall_seconds\": %.6f,\n  \"cpu_seconds\": %.6f,\n  \"stages\": {\n",
+            status, total->wall, total->cpu);
+
+    for (int i = 0; i < NUM_STAGES; i++) {
+        fprintf(f, "    \"%s\": {\"wall_seconds\": %.6f, \"cpu_seconds\": %.6f}%s\n", get_stage_name((Stage) i),
+                stats->stages[i].wall, stats->stages[i].cpu, (i + 1 < NUM_STAGES) ? "," : "");
+    }
+
+    fprintf(f, "  },\n  \"vertices\": %zu,\n  \"triangles\": %zu,\n  \"files\": %d,\n  \"bytes\": %zu,\n",
+            stats->num_pts, stats->num_tris, stats->num_files, stats->num_bytes);
+    fprintf(f, "  \"triangles_per_second\": %.1f,\n  \"bytes_per_second\": %.1f,\n  \"peak_memory_bytes\": %zu\n}\n",
+            (double) stats->num_tris / wall, (double) stats->num_bytes / wall, get_peak_memory());
+
+    if (fclose(f) != 0) {
+        fprintf(stderr, "wingstl: error: unable to write report file '%s'\n", fname);
+        return 1;
+    }
+
+    return 0;
+}
+
+int report_stats(const Settings *settings, const Stats *stats, const Timer *run, int status) {
+    StageTime total = {
+        .wall = get_wall_time() - run->start.wall,
+        .cpu = get_cpu_time(true) - run->start.cpu
+    };
+
+    if (strcmp(settings->report, REPORT_STDOUT) == 0) {
+        putchar('\n');
+        show_report(stats, &total);
+        return 0;
+    }
+
+    return write_report(settings->report, stats, &total, status);
+}
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
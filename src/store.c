@@ -0,0 +1,384 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include <sys/stat.h>
+
+#include "store.h"
+#include "utils.h"
+#include "types.h"
+#include "fileio.h"
+#include "constants.h"
+
+uint64_t get_store_key(const Settings *settings, StoreKey *key) {
+    const Airfoil *airfoil = &settings->airfoil;
+    bool is_naca4 = (airfoil->num_pts == 0);
+    bool is_ascii = (settings->format == ASCII_STL || settings->format == ASCII_OBJ || settings->format == THREE_MF);
+
+    memset(key, 0, sizeof(StoreKey));
+
+    key->version = STORE_VERSION;
+    key->units = settings->units;
+    key->format = settings->format;
+    key->spacing = settings->spacing;
+    key->decimals = is_ascii ? settings->decimals : 0;
+    key->num_slices = settings->num_slices;
+    key->num_pts_chord = settings->num_pts_chord;
+    key->num_airfoil_pts = airfoil->num_pts;
+    key->lednicer_index = airfoil->lednicer_index;
+    key->has_closed_te = airfoil->has_closed_te;
+    key->use_spline = !is_naca4 && settings->use_spline;
+    key->semi_span = settings->semi_span;
+    key->root_chord = settings->root_chord;
+    key->sweep_angles[0] = settings->sweep_angles[0];
+    key->sweep_angles[1] = settings->sweep_angles[1];
+
+    if (is_naca4) {
+        memcpy(key->naca, airfoil->header, 4);
+    }
+
+    uint64_t hash = hash_bytes(key, sizeof(StoreKey), FNV_OFFSET);
+
+    return is_naca4 ? hash : hash_bytes(airfoil->pts, airfoil->num_pts * sizeof(Vec2D), hash);
+}
+
+int get_num_entries(const Settings *settings) {
+    return (settings->format == THREE_MF) ? 1 : settings->num_slices;
+}
+
+size_t get_entry_length(const SliceContext *slices) {
+    return strlen(slices->store) + num_digits_in(slices->settings->num_slices) + 8;
+}
+
+void make_entry_path(const SliceContext *slices, int ientry, char *path) {
+    sprintf(path, "%s/%d%s", slices->store, ientry, get_format_ext(slices->settings->format));
+}
+
+void make_entry_output(const Settings *settings, int ientry, char *name) {
+    if (settings->format == THREE_MF) {
+        strcpy(name, settings->output);
+    } else {
+        make_slice_name(settings, ientry, name);
+    }
+}
+
+size_t get_record_size(const StoreKey *key, int num_entries) {
+    return sizeof(StoreRecord) + (size_t) key->num_airfoil_pts * sizeof(Vec2D) + (size_t) num_entries * sizeof(StoreEntry);
+}
+
+void make_record_path(const SliceContext *slices, char *path) {
+    sprintf(path, "%s/%s", slices->store, STORE_RECORD);
+}
+
+int read_store_record(SliceContext *slices, const StoreKey *key) {
+    const Airfoil *airfoil = &slices->settings->airfoil;
+    int num_entries = get_num_entries(slices->settings);
+
+    char *path = (char *) malloc((strlen(slices->store) + strlen(STORE_RECORD) + 2) * sizeof(char));
+
+    if (path == NULL) {
+        return 1;
+    }
+
+    make_record_path(slices, path);
+
+    const char *data = NULL;
+    size_t size = 0;
+    int status = map_file(path, &data, &size);
+
+    free(path);
+
+    if (status) {
+        return 1;
+    }
+
+    StoreRecord record;
+    memset(&record, 0, sizeof(StoreRecord));
+
+    if (size >= sizeof(StoreRecord)) {
+        memcpy(&record, data, sizeof(StoreRecord));
+    }
+
+    size_t pts_size = (size_t) key->num_airfoil_pts * sizeof(Vec2D);
+
+    bool is_valid = size == get_record_size(key, num_entries) && memcmp(record.magic, STORE_MAGIC, 4) == 0 &&
+        record.byte_order == CACHE_BYTE_ORDER && record.header_size == sizeof(StoreRecord) &&
+        record.num_entries == num_entries && memcmp(&record.key, key, sizeof(StoreKey)) == 0 &&
+        (pts_size == 0 || memcmp(data + sizeof(StoreRecord), airfoil->pts, pts_size) == 0);
+
+    if (is_valid) {
+        memcpy(slices->entries, data + sizeof(StoreRecord) + pts_size, (size_t) num_entries * sizeof(StoreEntry));
+    }
+
+    unmap_file(data, size);
+
+    return !is_valid;
+}
+
+int write_store_record(const SliceContext *slices, const StoreKey *key) {
+    const Airfoil *airfoil = &slices->settings->airfoil;
+    int num_entries = get_num_entries(slices->settings);
+
+    StoreRecord record;
+    memset(&record, 0, sizeof(StoreRecord));
+
+    memcpy(record.magic, STORE_MAGIC, 4);
+    record.byte_order = CACHE_BYTE_ORDER;
+    record.header_size = sizeof(StoreRecord);
+    record.num_entries = num_entries;
+    record.key = *key;
+
+    char *path = (char *) malloc((strlen(slices->store) + strlen(STORE_RECORD) + 2) * sizeof(char));
+    char *temp = (char *) malloc((strlen(slices->store) + strlen(STORE_RECORD) + 32) * sizeof(char));
+
+    if (path == NULL || temp == NULL) {
+        free(path);
+        free(temp);
+        return 1;
+    }
+
+    make_record_path(slices, path);
+    sprintf(temp, "%s.%ld.tmp", path, (long) getpid());
+
+    FILE *f = fopen(temp, "wb");
+    bool is_written = (f != NULL);
+
+    if (f != NULL) {
+        is_written = fwrite(&record, sizeof(StoreRecord), 1, f) == 1 &&
+            (key->num_airfoil_pts == 0 || fwrite(airfoil->pts, sizeof(Vec2D), key->num_airfoil_pts, f) == (size_t) key->num_airfoil_pts) &&
+            fwrite(slices->entries, sizeof(StoreEntry), num_entries, f) == (size_t) num_entries;
+
+        is_written = (fclose(f) == 0) && is_written;
+    }
+
+    is_written = is_written && rename(temp, path) == 0;
+
+    if (!is_written) {
+        remove(temp);
+    }
+
+    free(path);
+    free(temp);
+
+    return !is_written;
+}
+
+int hash_file(const char *fname, StoreEntry *entry) {
+    const char *data = NULL;
+    size_t size = 0;
+
+    if (map_file(fname, &data, &size)) {
+        return 1;
+    }
+
+    entry->size = size;
+    entry->hash = hash_bytes(data, size, FNV_OFFSET);
+    unmap_file(data, size);
+
+    return 0;
+}
+
+int copy_file(const char *src, const char *dst) {
+    int in = open(src, O_RDONLY);
+
+    if (in < 0) {
+        return 1;
+    }
+
+    int out = open(dst, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+
+    if (out < 0) {
+        close(in);
+        return 1;
+    }
+
+    ssize_t num_copied = 0;
+
+#ifdef __linux__
+    while ((num_copied = copy_file_range(in, NULL, out, NULL, WRITE_BUFFER_SIZE, 0)) > 0);
+#else
+    num_copied = -1;
+#endif
+
+    if (num_copied < 0 && lseek(in, 0, SEEK_SET) == 0 && ftruncate(out, 0) == 0 && lseek(out, 0, SEEK_SET) == 0) {
+        char *buffer = (char *) malloc(WRITE_BUFFER_SIZE);
+        ssize_t num_read = (buffer == NULL) ? -1 : 0;
+
+        while (buffer != NULL && (num_read = read(in, buffer, WRITE_BUFFER_SIZE)) > 0) {
+            if (write(out, buffer, num_read) != num_read) {
+                num_read = -1;
+                break;
+            }
+        }
+
+        num_copied = num_read;
+        free(buffer);
+    }
+
+    int status = (close(out) != 0) || (num_copied < 0);
+    close(in);
+
+    return status;
+}
+
+int install_file(const char *src, const char *dst) {
+    char *temp = (char *) malloc((strlen(dst) + 32) * sizeof(char));
+
+    if (temp == NULL) {
+        return 1;
+    }
+
+    sprintf(temp, "%s.%ld.tmp", dst, (long) getpid());
+    remove(temp);
+
+    bool is_installed = copy_file(src, temp) == 0 && rename(temp, dst) == 0;
+
+    remove(temp);
+    free(temp);
+
+    return !is_installed;
+}
+
+int open_store(SliceContext *slices) {
+    const Settings *settings = slices->settings;
+
+    slices->store = NULL;
+    slices->restored = NULL;
+    slices->entries = NULL;
+    slices->num_restored = 0;
+
+    if (settings->store_dir == NULL) {
+        return 0;
+    }
+
+    int num_entries = get_num_entries(settings);
+
+    slices->store = (char *) malloc((strlen(settings->store_dir) + 18) * sizeof(char));
+    slices->restored = (bool *) calloc(num_entries, sizeof(bool));
+    slices->entries = (StoreEntry *) calloc(num_entries, sizeof(StoreEntry));
+
+    if (slices->store == NULL || slices->restored == NULL || slices->entries == NULL) {
+        fprintf(stderr, "wingstl: error: unable to allocate memory for output cache\n");
+        return 1;
+    }
+
+    StoreKey key;
+    sprintf(slices->store, "%s/%016llx", settings->store_dir, (unsigned long long) get_store_key(settings, &key));
+
+    if (read_store_record(slices, &key)) {
+        return 0;
+    }
+
+    char *path = (char *) malloc(get_entry_length(slices) * sizeof(char));
+    char *name = (char *) malloc(get_name_length(settings) * sizeof(char));
+
+    if (path == NULL || name == NULL) {
+        fprintf(stderr, "wingstl: error: unable to allocate memory for output cache\n");
+        free(path);
+        free(name);
+        return 1;
+    }
+
+    StoreEntry entry;
+
+    for (int i = 0; i < num_entries; i++) {
+        make_entry_path(slices, i, path);
+        make_entry_output(settings, i, name);
+
+        if (hash_file(path, &entry) || entry.size != slices->entries[i].size || entry.hash != slices->entries[i].hash) {
+            continue;
+        }
+
+        if (!install_file(path, name)) {
+            slices->restored[i] = true;
+            slices->num_restored++;
+        }
+    }
+
+    free(path);
+    free(name);
+
+    if (settings->verbose && slices->num_restored > 0) {
+        printf("(%d/%d) files restored from output cache\n", slices->num_restored, num_entries);
+    }
+
+    return 0;
+}
+
+void store_slices(SliceContext *slices) {
+    const Settings *settings = slices->settings;
+    int num_entries = get_num_entries(settings);
+
+    if (slices->store == NULL || slices->num_restored == num_entries) {
+        return;
+    }
+
+    mkdir(settings->store_dir, 0777);
+    mkdir(slices->store, 0777);
+
+    char *path = (char *) malloc(get_entry_length(slices) * sizeof(char));
+    char *name = (char *) malloc(get_name_length(settings) * sizeof(char));
+
+    bool is_stored = (path != NULL && name != NULL);
+
+    for (int i = 0; i < num_entries && is_stored; i++) {
+        if (slices->restored[i]) {
+            continue;
+        }
+
+        make_entry_path(slices, i, path);
+        make_entry_output(settings, i, name);
+
+        is_stored = !hash_file(name, slices->entries + i) && !install_file(name, path);
+    }
+
+    StoreKey key;
+    get_store_key(settings, &key);
+
+    is_stored = is_stored && !write_store_record(slices, &key);
+
+    if (!is_stored) {
+        fprintf(stderr, "wingstl: warning: unable to write output cache entry in '%s'\n", settings->store_dir);
+    }
+
+    free(path);
+    free(name);
+}
+
+void close_store(SliceContext *slices) {
+    free(slices->store);
+    free(slices->restored);
+    free(slices->entries);
+
+    slices->store = NULL;
+    slices->restored = NULL;
+    slices->entries = NULL;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
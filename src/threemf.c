@@ -0,0 +1,305 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "utils.h"
+#include "types.h"
+#include "fileio.h"
+#include "threemf.h"
+#include "constants.h"
+
+size_t get_written(const Writer *writer) {
+    return writer->sink.target_size + writer->size;
+}
+
+int write_zip_header(Writer *writer, uint32_t signature, const ZipEntry *entry) {
+    size_t name_length = strlen(entry->name);
+    bool is_central = (signature == ZIP_CENTRAL_SIG);
+    size_t size = is_central ? ZIP_CENTRAL_SIZE : ZIP_LOCAL_SIZE;
+
+    unsigned char *record = (unsigned char *) reserve_bytes(writer, size + name_length);
+
+    if (record == NULL) {
+        return 1;
+    }
+
+    memset(record, 0, size);
+    put_uint32(record, signature);
+
+    unsigned char *fields = record + (is_central ? 6 : 4);
+
+    if (is_central) {
+        put_uint16(record + 4, ZIP_VERSION);
+    }
+
+    put_uint16(fields, ZIP_VERSION);
+    put_uint16(fields + 2, ZIP_FLAG_DESCRIPTOR);
+    put_uint16(fields + 8, ZIP_DOS_DATE);
+    put_uint32(fields + 10, entry->crc);
+    put_uint32(fields + 14, (uint32_t) entry->size);
+    put_uint32(fields + 18, (uint32_t) entry->size);
+    put_uint16(fields + 22, (uint16_t) name_length);
+
+    if (is_central) {
+        put_uint32(record + 42, (uint32_t) entry->offset);
+    }
+
+    memcpy(record + size, entry->name, name_length);
+    commit_bytes(writer, size + name_length);
+
+    return 0;
+}
+
+int begin_entry(Package *package, const char *name) {
+    Writer *writer = package->writer;
+    ZipEntry *entry = package->entries + package->num_entries;
+
+    *entry = (ZipEntry) {.name = name, .crc = 0, .size = 0, .offset = get_written(writer)};
+
+    if (write_zip_header(writer, ZIP_LOCAL_SIG, entry) || flush_writer(writer)) {
+        return 1;
+    }
+
+    writer->crc = 0;
+    writer->crc_table = package->crc_table;
+
+    return 0;
+}
+
+int end_entry(Package *package) {
+    Writer *writer = package->writer;
+    ZipEntry *entry = package->entries + package->num_entries;
+
+    if (flush_writer(writer)) {
+        return 1;
+    }
+
+    writer->crc_table = NULL;
+    entry->crc = writer->crc;
+    entry->size = get_written(writer) - entry->offset - ZIP_LOCAL_SIZE - strlen(entry->name);
+    package->num_entries++;
+
+    if (entry->size > UINT32_MAX) {
+        fprintf(stderr, "wingstl: error: 3MF model is larger than 4 GiB\n");
+        return 1;
+    }
+
+    unsigned char *record = (unsigned char *) reserve_bytes(writer, ZIP_DESCRIPTOR_SIZE);
+
+    if (record == NULL) {
+        return 1;
+    }
+
+    put_uint32(record, ZIP_DESCRIPTOR_SIG);
+    put_uint32(record + 4, entry->crc);
+    put_uint32(record + 8, (uint32_t) entry->size);
+    put_uint32(record + 12, (uint32_t) entry->size);
+    commit_bytes(writer, ZIP_DESCRIPTOR_SIZE);
+
+    return 0;
+}
+
+int write_central_directory(Package *package) {
+    Writer *writer = package->writer;
+    size_t offset = get_written(writer);
+
+    for (int i = 0; i < package->num_entries; i++) {
+        if (write_zip_header(writer, ZIP_CENTRAL_SIG, package->entries + i)) {
+            return 1;
+        }
+    }
+
+    size_t size = get_written(writer) - offset;
+
+    if (offset > UINT32_MAX) {
+        fprintf(stderr, "wingstl: error: 3MF package is larger than 4 GiB\n");
+        return 1;
+    }
+
+    unsigned char *record = (unsigned char *) reserve_bytes(writer, ZIP_END_SIZE);
+
+    if (record == NULL) {
+        return 1;
+    }
+
+    memset(record, 0, ZIP_END_SIZE);
+    put_uint32(record, ZIP_END_SIG);
+    put_uint16(record + 8, (uint16_t) package->num_entries);
+    put_uint16(record + 10, (uint16_t) package->num_entries);
+    put_uint32(record + 12, (uint32_t) size);
+    put_uint32(record + 16, (uint32_t) offset);
+    commit_bytes(writer, ZIP_END_SIZE);
+
+    return 0;
+}
+
+int open_package(Package *package, Writer *writer, const char *fname) {
+    if (open_writer(writer, fname)) {
+        return 1;
+    }
+
+    package->writer = writer;
+    package->num_entries = 0;
+    make_crc_table(package->crc_table);
+
+    char header[MAX_HEADER_CHARS];
+
+    sprintf(header, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                    "<model unit=\"%s\" xml:lang=\"en-US\" xmlns=\"http://schemas.microsoft.com/3dmanufacturing/core/2015/02\">\n"
+                    "<metadata name=\"Application\">wingstl</metadata>\n<resources>\n", THREE_MF_UNIT);
+
+    int status = begin_entry(package, "[Content_Types].xml") ||
+                 write_text(writer, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                                    "<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+                                    "<Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+                                    "<Default Extension=\"model\" ContentType=\"application/vnd.ms-package.3dmanufacturing-3dmodel+xml\"/>"
+                                    "</Types>\n") ||
+                 end_entry(package) ||
+                 begin_entry(package, "_rels/.rels") ||
+                 write_text(writer, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                                    "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+                                    "<Relationship Target=\"/3D/3dmodel.model\" Id=\"rel0\" "
+                                    "Type=\"http://schemas.microsoft.com/3dmanufacturing/2013/01/3dmodel\"/>"
+                                    "</Relationships>\n") ||
+                 end_entry(package) ||
+                 begin_entry(package, "3D/3dmodel.model") ||
+                 write_text(writer, header);
+
+    if (status) {
+        writer->crc_table = NULL;
+        close_writer(writer);
+    }
+
+    return status;
+}
+
+int close_package(Package *package, int num_objects) {
+    Writer *writer = package->writer;
+    char item[MAX_HEADER_CHARS];
+
+    int status = write_text(writer, "</resources>\n<build>\n");
+
+    for (int id = 1; id <= num_objects && !status; id++) {
+        sprintf(item, "<item objectid=\"%d\"/>\n", id);
+        status = write_text(writer, item);
+    }
+
+    status = status || write_text(writer, "</build>\n</model>\n") || end_entry(package) || write_central_directory(package);
+
+    writer->crc_table = NULL;
+
+    if (close_writer(writer)) {
+        status = 1;
+    }
+
+    return status;
+}
+
+int write_3mf_object(Writer *writer, const Vec3D *pts, size_t num_pts, const Index *indices, size_t num_tris, int id, int decimals) {
+    char header[MAX_HEADER_CHARS];
+
+    sprintf(header, "<object id=\"%d\" type=\"model\" name=\"slice %d\">\n<mesh>\n<vertices>\n", id, id - 1);
+
+    if (write_text(writer, header)) {
+        return 1;
+    }
+
+    char *start = NULL;
+    char *ptr = NULL;
+
+    for (size_t i = 0; i < num_pts; i++) {
+        start = reserve_bytes(writer, MAX_FACET_CHARS);
+
+        if (start == NULL) {
+            return 1;
+        }
+
+        ptr = append_text(start, "<vertex x=\"");
+        ptr += format_float(ptr, pts[i].x, decimals);
+        ptr = append_text(ptr, "\" y=\"");
+        ptr += format_float(ptr, pts[i].y, decimals);
+        ptr = append_text(ptr, "\" z=\"");
+        ptr += format_float(ptr, pts[i].z, decimals);
+        ptr = append_text(ptr, "\"/>\n");
+        commit_bytes(writer, (size_t) (ptr - start));
+    }
+
+    if (write_text(writer, "</vertices>\n<triangles>\n")) {
+        return 1;
+    }
+
+    const char *names[] = {"<triangle v1=\"", "\" v2=\"", "\" v3=\""};
+    size_t k = 0;
+
+    for (size_t i = 0; i < num_tris; i++) {
+        start = reserve_bytes(writer, MAX_FACET_CHARS);
+
+        if (start == NULL) {
+            return 1;
+        }
+
+        ptr = start;
+
+        for (int j = 0; j < 3; j++) {
+            ptr = append_text(ptr, names[j]);
+            ptr += format_index(ptr, (size_t) indices[k++]);
+        }
+
+        ptr = append_text(ptr, "\"/>\n");
+        commit_bytes(writer, (size_t) (ptr - start));
+    }
+
+    return write_text(writer, "</triangles>\n</mesh>\n</object>\n");
+}
+
+int write_3mf(const Settings *settings, Writer *writer, const Vec3D *pts, size_t num_pts, const Index *indices, size_t num_tris, const char *fname) {
+    Package package;
+
+    if (open_package(&package, writer, fname)) {
+        return 1;
+    }
+
+    if (write_3mf_object(writer, pts, num_pts, indices, num_tris, 1, settings->decimals)) {
+        writer->crc_table = NULL;
+        close_writer(writer);
+        return 1;
+    }
+
+    return close_package(&package, 1);
+}
+
+size_t get_package_overhead(const Settings *settings, Writer *counter) {
+    Package package;
+
+    if (open_package(&package, counter, NULL) || close_package(&package, settings->num_slices)) {
+        return 0;
+    }
+
+    return counter->sink.target_size;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
@@ -9,6 +9,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
 
 #include "types.h"
@@ -19,7 +20,7 @@ float to_radians(float degrees) {
     return degrees * PI_OVER_180;
 }
 
-float interp(Vec2D *p0, Vec2D *p2, float x) {
+float interp(const Vec2D *p0, const Vec2D *p2, float x) {
     return p0->y + (p2->y - p0->y) * (x - p0->x) / (p2->x - p0->x); 
 }
 
@@ -50,6 +51,18 @@ bool has_ext(char *arg, const char *ext) {
     return ((ptr != NULL) && (ptr == arg + arg_len - ext_len));
 }
 
+bool has_mesh_ext(char *arg) {
+    const char *exts[] = {".stl", ".STL", ".ply", ".PLY", ".obj", ".OBJ", ".3mf", ".3MF"};
+
+    for (int i = 0; i < 8; i++) {
+        if (has_ext(arg, exts[i])) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void rstrip(char *line) {
     size_t length = strlen(line);
 
@@ -79,6 +92,82 @@ Units to_units(const char *str) {
     }
 }
 
+Format to_format(const char *str) {
+    if (strcmp(str, "ascii") == 0) {
+        return ASCII_STL;
+    } else if (strcmp(str, "binary") == 0) {
+        return BINARY_STL;
+    } else if (strcmp(str, "ply") == 0) {
+        return BINARY_PLY;
+    } else if (strcmp(str, "obj") == 0) {
+        return ASCII_OBJ;
+    } else if (strcmp(str, "3mf") == 0) {
+        return THREE_MF;
+    } else {
+        return UNKNOWN_FORMAT;
+    }
+}
+
+Spacing to_spacing(const char *str) {
+    if (strcmp(str, "cosine") == 0) {
+        return COSINE_SPACING;
+    } else if (strcmp(str, "arc") == 0) {
+        return ARC_SPACING;
+    } else if (strcmp(str, "curvature") == 0) {
+        return CURVATURE_SPACING;
+    } else {
+        return UNKNOWN_SPACING;
+    }
+}
+
+const char *get_spacing_name(Spacing spacing) {
+    switch (spacing) {
+        case ARC_SPACING:
+            return "arc";
+        case CURVATURE_SPACING:
+            return "curvature";
+        default:
+            return "cosine";
+    }
+}
+
+const char *get_format_name(Format format) {
+    switch (format) {
+        case BINARY_STL:
+            return "binary";
+        case BINARY_PLY:
+            return "ply";
+        case ASCII_OBJ:
+            return "obj";
+        case THREE_MF:
+            return "3mf";
+        default:
+            return "ascii";
+    }
+}
+
+const char *get_format_ext(Format format) {
+    switch (format) {
+        case BINARY_PLY:
+            return ".ply";
+        case ASCII_OBJ:
+            return ".obj";
+        case THREE_MF:
+            return ".3mf";
+        default:
+            return ".stl";
+    }
+}
+
+bool is_little_endian(void) {
+    uint16_t value = 1;
+    return *(unsigned char *) &value == 1;
+}
+
+bool is_indexed(Format format) {
+    return format == BINARY_PLY || format == ASCII_OBJ || format == THREE_MF;
+}
+
 float to_meters(float value, Units units) {
     switch (units) {
         case FEET:
@@ -100,6 +189,10 @@ float to_meters(float value, Units units) {
     }
 }
 
+size_t mul_size(size_t a, size_t b) {
+    return (a != 0 && b > SIZE_MAX / a) ? SIZE_MAX : a * b;
+}
+
 size_t sub2ind(int i, int j, int num_cols) {
     return (size_t) i * num_cols + j;
 }
@@ -126,6 +219,189 @@ void normalize(Vec3D *v) {
     }
 }
 
+bool scale_float(float value, int decimals, uint64_t *scaled) {
+    static const uint64_t powers[] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL,
+        1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL
+    };
+
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    int biased = (int) ((bits >> 23) & 0xFF);
+    uint64_t mantissa = bits & 0x7FFFFF;
+    int exponent = -149;
+
+    if (biased > 0) {
+        mantissa |= 0x800000;
+        exponent = biased - 150;
+    }
+
+    uint64_t product = mantissa * powers[decimals];
+
+    if (exponent >= 0) {
+        *scaled = product << exponent;
+        return true;
+    }
+
+    int shift = -exponent;
+
+    if (shift > 54) {
+        *scaled = 0;
+        return mantissa == 0;
+    }
+
+    uint64_t remainder = product & ((1ULL << shift) - 1);
+    uint64_t half = 1ULL << (shift - 1);
+
+    *scaled = product >> shift;
+
+    if (remainder > half || (remainder == half && (*scaled & 1))) {
+        *scaled += 1;
+        remainder = (1ULL << shift) - remainder;
+    }
+
+    uint64_t gap = (mantissa == 0x800000) ? 4 : 2;
+    return remainder * gap < powers[decimals];
+}
+
+size_t format_float(char *dst, float value, int decimals) {
+    if (!isfinite(value) || fabsf(value) >= FORMAT_FLOAT_LIMIT) {
+        return (size_t) sprintf(dst, "%.*f", decimals ? decimals : 1, value);
+    }
+
+    uint64_t scaled;
+    bool round_trips = false;
+
+    if (decimals > 0) {
+        scale_float(value, decimals, &scaled);
+    } else {
+        for (decimals = 1; decimals <= MAX_DECIMALS && !round_trips; decimals++) {
+            round_trips = scale_float(value, decimals, &scaled);
+        }
+
+        if (!round_trips) {
+            int length = 0;
+
+            for (int precision = 1; precision <= MAX_FLOAT_DIGITS; precision++) {
+                length = sprintf(dst, "%.*g", precision, value);
+
+                if (strtof(dst, NULL) == value) {
+                    break;
+                }
+            }
+
+            return (size_t) length;
+        }
+
+        decimals--;
+    }
+
+    char digits[24];
+    int num_digits = 0;
+
+    do {
+        digits[num_digits++] = (char) ('0' + scaled % 10);
+        scaled /= 10;
+    } while (scaled > 0 || num_digits <= decimals);
+
+    char *ptr = dst;
+
+    if (signbit(value)) {
+        *ptr++ = '-';
+    }
+
+    while (num_digits > decimals) {
+        *ptr++ = digits[--num_digits];
+    }
+
+    *ptr++ = '.';
+
+    while (num_digits > 0) {
+        *ptr++ = digits[--num_digits];
+    }
+
+    return (size_t) (ptr - dst);
+}
+
+void put_uint16(unsigned char *dst, uint16_t value) {
+    dst[0] = (unsigned char) (value & 0xFF);
+    dst[1] = (unsigned char) (value >> 8);
+}
+
+size_t format_index(char *dst, size_t value) {
+    char digits[24];
+    size_t length = 0;
+
+    do {
+        digits[length++] = (char) ('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    for (size_t i = 0; i < length; i++) {
+        dst[i] = digits[length - 1 - i];
+    }
+
+    return length;
+}
+
+void *copy_bytes(const void *src, size_t num_bytes) {
+    void *dst = malloc(num_bytes > 0 ? num_bytes : 1);
+
+    if (dst != NULL && num_bytes > 0) {
+        memcpy(dst, src, num_bytes);
+    }
+
+    return dst;
+}
+
+uint64_t hash_bytes(const void *data, size_t size, uint64_t hash) {
+    const unsigned char *bytes = (const unsigned char *) data;
+
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+void put_uint32(unsigned char *dst, uint32_t value) {
+    dst[0] = (unsigned char) (value & 0xFF);
+    dst[1] = (unsigned char) ((value >> 8) & 0xFF);
+    dst[2] = (unsigned char) ((value >> 16) & 0xFF);
+    dst[3] = (unsigned char) (value >> 24);
+}
+
+void make_crc_table(uint32_t *table) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+
+        for (int k = 0; k < 8; k++) {
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32_POLY : crc >> 1;
+        }
+
+        table[i] = crc;
+    }
+}
+
+uint32_t update_crc(const uint32_t *table, uint32_t crc, const void *data, size_t size) {
+    const unsigned char *bytes = (const unsigned char *) data;
+    crc = ~crc;
+
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+
+    return ~crc;
+}
+
+void put_float(unsigned char *dst, float value) {
+    uint32_t bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+    put_uint32(dst, bits);
+}
+
 /*
  * ------------------------------------------------------------------------
  * This file is part of wingstl.
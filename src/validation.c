@@ -8,8 +8,11 @@
 #include <string.h>
 #include <stdbool.h>
 
+#include "sink.h"
 #include "types.h"
+#include "utils.h"
 #include "engine.h"
+#include "estimate.h"
 #include "constants.h"
 #include "validation.h"
 
@@ -55,16 +58,16 @@ bool x_increases(const Airfoil *airfoil, int istart, int iend) {
     return true;
 }
 
-int validate_airfoil(const Airfoil *airfoil) {
+int validate_airfoil(const Airfoil *airfoil, bool quiet) {
     if (airfoil->num_pts < 0) {
-        suggest_flag_and_value("airfoil .dat file or 4-digit naca code", FLAG_AIRFOIL);
+        if (!quiet) suggest_flag_and_value("airfoil .dat file or 4-digit naca code", FLAG_AIRFOIL);
         return 1;
     }
 
     bool is_naca4 = !airfoil->num_pts;
 
     if (is_naca4 && strlen(airfoil->header) != 4) {
-        fprintf(stderr, "wingstl: error: naca airfoil code must be exactly 4 digits\n");
+        if (!quiet) fprintf(stderr, "wingstl: error: naca airfoil code must be exactly 4 digits\n");
         return 1;
     }
 
@@ -74,42 +77,37 @@ int validate_airfoil(const Airfoil *airfoil) {
     }
 
     if (is_naca4 && !is_all_digits) {
-        fprintf(stderr, "wingstl: error: naca airfoil code must contain only 4 digits\n");
+        if (!quiet) fprintf(stderr, "wingstl: error: naca airfoil code must contain only 4 digits\n");
         return 1;
     }
 
     if (is_naca4 && airfoil->header[2] == '0' && airfoil->header[3] == '0') {
-        fprintf(stderr, "wingstl: error: naca airfoil code will result in zero thickness\n");
+        if (!quiet) fprintf(stderr, "wingstl: error: naca airfoil code will result in zero thickness\n");
         return 1;
     }
 
     if (!is_naca4 && airfoil->num_pts < MIN_AIRFOIL_PTS) {
-        fprintf(stderr, "wingstl: error: less than %d points loaded from airfoil .dat file\n", MIN_AIRFOIL_PTS);
-        return 1;
-    }
-
-    if (!is_naca4 && airfoil->num_pts > MAX_AIRFOIL_PTS) {
-        fprintf(stderr, "wingstl: error: more than %d points loaded from airfoil .dat file\n", MAX_AIRFOIL_PTS);
+        if (!quiet) fprintf(stderr, "wingstl: error: less than %d points loaded from airfoil .dat file\n", MIN_AIRFOIL_PTS);
         return 1;
     }
 
     bool is_selig = !is_naca4 && airfoil->num_pts && !airfoil->lednicer_index;
 
     if (is_selig && !x_decreases_then_increases(airfoil, 0, airfoil->num_pts)) {
-        fprintf(stderr, "wingstl: error: airfoil .dat file points are not ordered correctly\n");
+        if (!quiet) fprintf(stderr, "wingstl: error: airfoil .dat file points are not ordered correctly\n");
         return 1;
     }
 
     bool is_lednicer = !is_naca4 && airfoil->num_pts && airfoil->lednicer_index;
 
     if (is_lednicer && !x_increases(airfoil, 0, airfoil->lednicer_index)) {
-        fprintf(stderr, "wingstl: error: airfoil .dat file points are not ordered correctly\n");
+        if (!quiet) fprintf(stderr, "wingstl: error: airfoil .dat file points are not ordered correctly\n");
         return 1;
     }
 
     if (is_lednicer && !x_increases(airfoil, airfoil->lednicer_index, airfoil->num_pts)) {
         if (!x_decreases_then_increases(airfoil, airfoil->lednicer_index, airfoil->num_pts)) {
-            fprintf(stderr, "wingstl: error: airfoil .dat file points are not ordered correctly\n");
+            if (!quiet) fprintf(stderr, "wingstl: error: airfoil .dat file points are not ordered correctly\n");
             return 1;
         }
     }
@@ -117,8 +115,43 @@ int validate_airfoil(const Airfoil *airfoil) {
     return 0;
 }
 
+int validate_mesh(const Settings *settings) {
+    size_t num_cols = (settings->stream || is_indexed(settings->format)) ? 2 : (size_t) settings->num_slices + 1;
+    size_t num_pts = mul_size(num_cols, get_num_col_pts(settings));
+    size_t num_indices = mul_size(3, get_num_tris(settings));
+
+    if (mul_size(num_pts, sizeof(Vec3D)) == SIZE_MAX || mul_size(num_indices, sizeof(Index)) == SIZE_MAX) {
+        fprintf(stderr, "wingstl: error: requested mesh is too large to address; ");
+        fprintf(stderr, "try reducing '%s' or '%s'\n", FLAG_CHORD_PTS, FLAG_NUM_SLICES);
+
+        return 1;
+    }
+
+    if (num_pts - 1 > MAX_INDEX) {
+        fprintf(stderr, "wingstl: error: mesh has too many vertices for %d-bit indices; ", INDEX_BITS);
+        fprintf(stderr, "try reducing '%s' or '%s', or streaming with '%s'\n", FLAG_CHORD_PTS, FLAG_NUM_SLICES, FLAG_STREAM);
+
+        return 1;
+    }
+
+    int num_workers = (settings->num_threads < settings->num_slices) ? settings->num_threads : settings->num_slices;
+    size_t memory = get_memory_estimate(settings, (num_workers > 1) ? num_workers : 1);
+    size_t physical = get_physical_memory();
+
+    if (!settings->estimate && physical != SIZE_MAX && memory > physical) {
+        fprintf(stderr, "wingstl: error: estimated peak memory of %.2f MiB exceeds the %.2f MiB of physical memory; ",
+                (double) memory / BYTES_PER_MIB, (double) physical / BYTES_PER_MIB);
+        fprintf(stderr, "try reducing '%s', '%s' or '%s', or streaming with '%s'\n",
+                FLAG_NUM_THREADS, FLAG_CHORD_PTS, FLAG_NUM_SLICES, FLAG_STREAM);
+
+        return 1;
+    }
+
+    return 0;
+}
+
 int validate_settings(const Settings *settings) {
-    if (validate_airfoil(&settings->airfoil)) {
+    if (validate_airfoil(&settings->airfoil, false)) {
         return 1;
     }
 
@@ -139,6 +172,35 @@ int validate_settings(const Settings *settings) {
         return 1;
     }
 
+    if (validate_mesh(settings)) {
+        return 1;
+    }
+
+    SinkKind sink = to_sink_kind(settings->output);
+
+    if (sink == FD_SINK && get_sink_fd(settings->output) < 0) {
+        fprintf(stderr, "wingstl: error: output '%s' must name a file descriptor number, as in '%s3'\n", settings->output, OUTPUT_FD_PREFIX);
+        return 1;
+    }
+
+    if (sink != FILE_SINK && settings->num_slices > 1 && settings->format != THREE_MF) {
+        fprintf(stderr, "wingstl: error: output to stdout or a file descriptor needs a single slice; ");
+        fprintf(stderr, "try '%s 1' or a file name for '%s'\n", FLAG_NUM_SLICES, FLAG_OUTPUT);
+        return 1;
+    }
+
+    if (sink != FILE_SINK && settings->store_dir != NULL) {
+        fprintf(stderr, "wingstl: error: output cache (flag '%s') needs a file name for '%s'\n", FLAG_STORE, FLAG_OUTPUT);
+        return 1;
+    }
+
+    bool reports_to_stdout = settings->verbose || (settings->report != NULL && strcmp(settings->report, REPORT_STDOUT) == 0);
+
+    if (sink == STDOUT_SINK && reports_to_stdout) {
+        fprintf(stderr, "wingstl: error: output to stdout cannot be combined with '%s' or '%s %s'\n", FLAG_VERBOSE, FLAG_REPORT, REPORT_STDOUT);
+        return 1;
+    }
+
     float aspect_ratio = get_aspect_ratio(settings);
     if (aspect_ratio < MIN_ASPECT_RATIO || aspect_ratio > MAX_ASPECT_RATIO) {
         fprintf(stderr, "wingstl: error: extreme aspect ratio detected; ");
@@ -151,37 +213,41 @@ int validate_settings(const Settings *settings) {
 }
 
 int validate_file(int num_breaks, int num_quantity, int num_invalid,
-                        bool has_break_b4_p0, bool has_empty_header) {
+                        bool has_break_b4_p0, bool has_empty_header, bool quiet) {
     if (has_empty_header) {
-        fprintf(stderr, "wingstl: error: .dat file does not contain a header on the first line\n");
+        if (!quiet) fprintf(stderr, "wingstl: error: .dat file does not contain a header on the first line\n");
         return 1;
     }
 
     if (num_invalid > 0) {
-        fprintf(stderr, "wingstl: error: line %d of .dat file is not formatted correctly\n", num_invalid);
+        if (!quiet) fprintf(stderr, "wingstl: error: line %d of .dat file is not formatted correctly\n", num_invalid);
         return 1;
     }
 
     if (num_breaks > 1) {
-        fprintf(stderr, "wingstl: error: .dat file contains multiple line breaks between points\n");
+        if (!quiet) fprintf(stderr, "wingstl: error: .dat file contains multiple line breaks between points\n");
         return 1;
     }
 
     if (num_quantity > 1) {
-        fprintf(stderr, "wingstl: error: .dat file contains multiple lines with point quantities\n");
+        if (!quiet) fprintf(stderr, "wingstl: error: .dat file contains multiple lines with point quantities\n");
         return 1;
     }
 
     if (num_quantity == 1 && num_breaks == 0) {
-        fprintf(stderr, "wingstl: error: .dat file contains a line with point quantities");
-        fprintf(stderr, "but does not contains a middle line break between points\n");
+        if (!quiet) {
+            fprintf(stderr, "wingstl: error: .dat file contains a line with point quantities");
+            fprintf(stderr, "but does not contains a middle line break between points\n");
+        }
 
         return 1;
     }
 
     if (num_breaks == 1 && !has_break_b4_p0) {
-        fprintf(stderr, "wingstl: error: .dat file contains a line break between points");
-        fprintf(stderr, "but does not contains a line break before the first point\n");
+        if (!quiet) {
+            fprintf(stderr, "wingstl: error: .dat file contains a line break between points");
+            fprintf(stderr, "but does not contains a line break before the first point\n");
+        }
 
         return 1;
     }
@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2025 Ethan Billingsley
+ * License: GPLv3 (see end of file for full notice, or LICENSE file in repo)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "wing.h"
+#include "utils.h"
+#include "types.h"
+#include "store.h"
+#include "stats.h"
+#include "fileio.h"
+#include "engine.h"
+#include "parallel.h"
+#include "threemf.h"
+
+int write_slice(void *context, int islice, int iworker) {
+    SliceContext *slices = (SliceContext *) context;
+    const Settings *settings = slices->settings;
+
+    Index *indices = slices->indices[iworker];
+    char *name = slices->names[iworker];
+    Vec3D *pts = slices->pts;
+    size_t num_pts = get_num_pts(settings);
+
+    Stats *stats = (slices->stats == NULL) ? NULL : slices->stats + iworker;
+    Timer timer;
+
+    if (slices->restored != NULL && slices->restored[islice]) {
+        return 0;
+    }
+
+    if (stats != NULL) {
+        start_timer(&timer, false);
+    }
+
+    if (settings->stream || is_indexed(settings->format)) {
+        pts = slices->slice_pts[iworker];
+        indices = slices->slice_indices;
+        num_pts = get_num_pts(&slices->slice_settings);
+        make_slice_pts(settings, &slices->profile, islice, pts);
+
+        stop_timer(&timer, stats, STAGE_POINTS);
+    } else {
+        assign_indices(settings, slices->num_tris, islice, indices);
+
+        stop_timer(&timer, stats, STAGE_INDICES);
+    }
+
+    make_slice_name(settings, islice, name);
+
+    if (stats == NULL) {
+        return write_mesh(settings, slices->writers + iworker, pts, num_pts, indices, slices->num_tris, name);
+    }
+
+    StageTime written = stats->stages[STAGE_WRITE];
+    start_timer(&timer, false);
+
+    int status = write_mesh(settings, slices->writers + iworker, pts, num_pts, indices, slices->num_tris, name);
+
+    stop_timer(&timer, stats, STAGE_FORMAT);
+    exclude_stage(stats, STAGE_FORMAT, STAGE_WRITE, &written);
+
+    if (!status) {
+        stats->num_files++;
+        stats->num_tris += slices->num_tris;
+        stats->num_pts += (pts == slices->pts) ? 0 : num_pts;
+    }
+
+    return status;
+}
+
+void report_slice(void *context, int islice) {
+    SliceContext *slices = (SliceContext *) context;
+
+    if (slices->restored != NULL && slices->restored[islice]) {
+        return;
+    }
+
+    slices->num_written++;
+
+    if (slices->settings->verbose) {
+        printf("(%d/%d) files written successfully\n", slices->num_written, slices->settings->num_slices);
+    }
+}
+
+int write_package(SliceContext *slices) {
+    const Settings *settings = slices->settings;
+    Writer *writer = slices->writers;
+    Stats *stats = slices->stats;
+
+    Vec3D *pts = slices->slice_pts[0];
+    size_t num_pts = get_num_pts(&slices->slice_settings);
+
+    Package package;
+    Timer timer;
+
+    if (open_package(&package, writer, settings->output)) {
+        return 1;
+    }
+
+    int status = 0;
+
+    for (int islice = 0; islice < settings->num_slices && !status; islice++) {
+        start_timer(&timer, false);
+        make_slice_pts(settings, &slices->profile, islice, pts);
+        stop_timer(&timer, stats, STAGE_POINTS);
+
+        StageTime written = (stats == NULL) ? (StageTime) {0} : stats->stages[STAGE_WRITE];
+        start_timer(&timer, false);
+
+        status = write_3mf_object(writer, pts, num_pts, slices->slice_indices, slices->num_tris, islice + 1, settings->decimals);
+
+        stop_timer(&timer, stats, STAGE_FORMAT);
+        exclude_stage(stats, STAGE_FORMAT, STAGE_WRITE, &written);
+
+        if (stats != NULL) {
+            stats->num_pts += num_pts;
+            stats->num_tris += slices->num_tris;
+        }
+    }
+
+    if (status) {
+        writer->crc_table = NULL;
+        close_writer(writer);
+        return 1;
+    }
+
+    status = close_package(&package, settings->num_slices);
+
+    if (!status && stats != NULL) {
+        stats->num_files++;
+    }
+
+    if (!status && settings->verbose) {
+        printf("(%d/%d) slices written to %s\n", settings->num_slices, settings->num_slices, settings->output);
+    }
+
+    return status;
+}
+
+void free_workspace(SliceContext *slices, int num_workers) {
+    for (int i = 0; i < num_workers; i++) {
+        if (slices->indices != NULL) free(slices->indices[i]);
+        if (slices->slice_pts != NULL) free(slices->slice_pts[i]);
+        if (slices->names != NULL) free(slices->names[i]);
+    }
+
+    free(slices->indices);
+    free(slices->slice_pts);
+    free(slices->names);
+    free(slices->slice_indices);
+    free(slices->pts);
+    free_profile(&slices->profile);
+}
+
+int alloc_workspace(SliceContext *slices, const Settings *settings, int num_workers) {
+    slices->indices = (Index **) calloc(num_workers, sizeof(Index *));
+    slices->slice_pts = (Vec3D **) calloc(num_workers, sizeof(Vec3D *));
+    slices->names = (char **) calloc(num_workers, sizeof(char *));
+
+    if (slices->indices == NULL || slices->slice_pts == NULL || slices->names == NULL) {
+        fprintf(stderr, "wingstl: error: unable to allocate memory for worker buffers\n");
+        return 1;
+    }
+
+    bool use_slice_pts = settings->stream || is_indexed(settings->format);
+    bool is_process = (settings->manifest == NULL);
+
+    if (use_slice_pts) {
+        make_slice_settings(settings, &slices->slice_settings);
+        slices->slice_indices = (Index *) malloc(3 * slices->num_tris * sizeof(Index));
+
+        if (slices->slice_indices == NULL) {
+            fprintf(stderr, "wingstl: error: unable to allocate memory for triangle indices\n");
+            return 1;
+        }
+
+        Timer timer;
+        start_timer(&timer, is_process);
+
+        assign_indices(&slices->slice_settings, slices->num_tris, 0, slices->slice_indices);
+        stop_timer(&timer, slices->stats, STAGE_INDICES);
+
+        start_timer(&timer, is_process);
+
+        if (make_profile(settings, &slices->profile)) {
+            fprintf(stderr, "wingstl: error: unable to allocate memory for section profile\n");
+            return 1;
+        }
+
+        stop_timer(&timer, slices->stats, STAGE_POINTS);
+    } else {
+        Timer timer;
+        start_timer(&timer, is_process);
+
+        slices->pts = make_pts(settings);
+
+        if (slices->pts == NULL) {
+            fprintf(stderr, "wingstl: error: unable to allocate memory for vertices\n");
+            return 1;
+        }
+
+        stop_timer(&timer, slices->stats, STAGE_POINTS);
+
+        if (slices->stats != NULL) {
+            slices->stats->num_pts += get_num_pts(settings);
+        }
+    }
+
+    for (int i = 0; i < num_workers; i++) {
+        if (use_slice_pts) {
+            slices->slice_pts[i] = (Vec3D *) malloc(get_num_pts(&slices->slice_settings) * sizeof(Vec3D));
+
+            if (slices->slice_pts[i] == NULL) {
+                fprintf(stderr, "wingstl: error: unable to allocate memory for vertices\n");
+                return 1;
+            }
+        } else {
+            slices->indices[i] = (Index *) malloc(3 * slices->num_tris * sizeof(Index));
+
+            if (slices->indices[i] == NULL) {
+                fprintf(stderr, "wingstl: error: unable to allocate memory for triangle indices\n");
+                return 1;
+            }
+        }
+
+        slices->names[i] = (char *) malloc(get_name_length(settings) * sizeof(char));
+
+        if (slices->names[i] == NULL) {
+            fprintf(stderr, "wingstl: error: unable to allocate memory for output file name\n");
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+int generate_wing(const Settings *settings, int num_workers, Writer *writers, Stats *stats) {
+    SliceContext slices = {
+        .settings = settings, .num_tris = get_num_tris(settings), .num_written = 0,
+        .pts = NULL, .slice_pts = NULL, .slice_indices = NULL, .indices = NULL, .names = NULL,
+        .writers = writers, .stats = NULL, .profile = {0},
+        .store = NULL, .restored = NULL, .entries = NULL, .num_restored = 0
+    };
+
+    if (stats != NULL) {
+        slices.stats = (Stats *) calloc(num_workers, sizeof(Stats));
+
+        if (slices.stats == NULL) {
+            fprintf(stderr, "wingstl: error: unable to allocate memory for run statistics\n");
+            return 1;
+        }
+
+        for (int i = 0; i < num_workers; i++) {
+            writers[i].stats = slices.stats + i;
+        }
+    }
+
+    int status = open_store(&slices);
+    bool is_restored = !status && slices.num_restored == get_num_entries(settings);
+
+    slices.num_written = slices.num_restored;
+
+    if (!status && !is_restored) {
+        status = alloc_workspace(&slices, settings, num_workers);
+    }
+
+    if (!status && !is_restored && settings->format == THREE_MF) {
+        status = write_package(&slices);
+    } else if (!status && !is_restored) {
+        status = run_parallel(num_workers, settings->num_slices, write_slice, report_slice, &slices);
+    }
+
+    if (!status) {
+        store_slices(&slices);
+    }
+
+    free_workspace(&slices, num_workers);
+    close_store(&slices);
+
+    if (stats != NULL) {
+        for (int i = 0; i < num_workers; i++) {
+            add_stats(stats, slices.stats + i);
+            writers[i].stats = NULL;
+        }
+
+        free(slices.stats);
+    }
+
+    return status;
+}
+
+/*
+ * ------------------------------------------------------------------------
+ * This file is part of wingstl.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ * ------------------------------------------------------------------------
+ */
@@ -8,102 +8,113 @@
 #include <stdlib.h>
 #include <stdbool.h>
 
+#include "wing.h"
+#include "batch.h"
 #include "utils.h"
 #include "types.h"
+#include "stats.h"
 #include "fileio.h"
 #include "engine.h"
+#include "estimate.h"
 #include "parsing.h"
+#include "spacing.h"
+#include "parallel.h"
 #include "messages.h"
 #include "constants.h"
 #include "validation.h"
 
 int main(int argc, char **argv) {
-    Settings settings = {
-        .units = to_units(DEFAULT_UNITS),
-        .airfoil = {DEFAULT_AIRFOIL},
-        .semi_span = DEFAULT_SEMI_SPAN,
-        .num_slices = DEFAULT_NUM_SLICES,
-        .root_chord = DEFAULT_ROOT_CHORD,
-        .sweep_angles = {DEFAULT_SWEEP_LE, DEFAULT_SWEEP_TE},
-        .num_pts_chord = DEFAULT_NUM_CHORD_PTS,
-        .verbose = false, .help = false, .output = NULL
-    };
-
-    if (handle_inputs(argc, argv, &settings) || validate_settings(&settings)) {
+    Timer run, setup;
+    start_timer(&run, true);
+    start_timer(&setup, true);
+
+    Settings settings;
+    init_settings(&settings);
+
+    Stats stats = {0};
+
+    if (handle_inputs(argc, argv, &settings)) {
         if (settings.help) {
             show_help();
-            free(settings.output);
+            free_settings(&settings);
             return 0;
         }
         
-        free(settings.output);
+        free_settings(&settings);
         return 1;
     }
 
-    Vec3D *pts = make_pts(&settings);
+    Stats *report = (settings.report == NULL) ? NULL : &stats;
+    stop_timer(&setup, report, STAGE_SETUP);
 
-    if (pts == NULL) {
-        fprintf(stderr, "wingstl: error: unable to allocate memory for vertices\n");
-        free(settings.output);
+    if (settings.manifest != NULL && settings.estimate) {
+        fprintf(stderr, "wingstl: error: flag ('%s') cannot be used with a manifest ('%s')\n", FLAG_ESTIMATE, FLAG_MANIFEST);
+        free_settings(&settings);
         return 1;
     }
 
-    size_t len_output = (settings.output == NULL) ? strlen(DEFAULT_OUTPUT) : strlen(settings.output);
-    size_t num_chars = len_output + num_digits_in(MAX_NUM_SLICES - 1) + 3;
-    size_t num_tris = get_num_tris(&settings);
-    size_t *indices = (size_t *) malloc(3 * num_tris * sizeof(size_t));
+    if (settings.manifest != NULL) {
+        int status = run_batch(&settings, argc, argv, report);
 
-    if (indices == NULL) {
-        fprintf(stderr, "wingstl: error: unable to allocate memory for triangle indices\n");
-        free(settings.output);
-        free(pts);
+        if (report != NULL && report_stats(&settings, report, &run, status)) {
+            status = 1;
+        }
+
+        free_settings(&settings);
+        return status;
+    }
 
+    if (validate_settings(&settings) || select_chord_pts(&settings)) {
+        free_settings(&settings);
         return 1;
     }
 
-    char *full_output = (char *) malloc(num_chars * sizeof(char));
+    int num_workers = (settings.num_threads < settings.num_slices) ? settings.num_threads : settings.num_slices;
 
-    if (full_output == NULL) {
-        fprintf(stderr, "wingstl: error: unable to allocate memory for output file name\n");
-        free(settings.output);
-        free(indices);
-        free(pts);
-        return 1;
+    if (settings.format == THREE_MF) {
+        num_workers = 1;
     }
 
-    for (int islice = 0; islice < settings.num_slices; islice++) {
-        assign_indices(&settings, num_tris, islice, indices);
-        strcpy(full_output, settings.output == NULL ? DEFAULT_OUTPUT : settings.output);
+    if (settings.estimate) {
+        int status = show_estimate(&settings, num_workers);
 
-        if (settings.num_slices > 1) {
-            sprintf(full_output + len_output - 4, "(%d).stl", islice);
-        }
+        free_settings(&settings);
+        return status;
+    }
 
-        if (write_stl(pts, indices, num_tris, full_output)) {
-            free(settings.output);
-            free(full_output);
-            free(indices);
-            free(pts);
+    if (check_budget(&settings, num_workers)) {
+        free_settings(&settings);
+        return 1;
+    }
 
-            return 1;
-        }
+    Writer *writers = (Writer *) calloc(num_workers, sizeof(Writer));
 
-        if (settings.verbose) {
-            printf("(%d/%d) files written successfully\n", islice + 1, settings.num_slices);
-        }
+    if (writers == NULL) {
+        fprintf(stderr, "wingstl: error: unable to allocate memory for worker buffers\n");
+        free_settings(&settings);
+        return 1;
+    }
+
+    int status = generate_wing(&settings, num_workers, writers, report);
+
+    for (int i = 0; i < num_workers; i++) {
+        free_writer(writers + i);
     }
 
-    if (settings.verbose) {
+    free(writers);
+
+    if (!status && settings.verbose) {
         putchar('\n');
         show_settings(&settings);
     }
-    
-    free(settings.output);
-    free(full_output);
-    free(indices);
-    free(pts);
 
-    return 0;
+    if (report != NULL && report_stats(&settings, report, &run, status)) {
+        status = 1;
+    }
+
+    free_settings(&settings);
+
+    return status;
 }
 
 /*